@@ -0,0 +1,43 @@
+/*
+BSD 2-Clause License
+Copyright (c) 2017, Davood Rasti and Alireza Rasti - rastisoft
+All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+//Kept compilable on its own, the preprocessor comments #version out when it is included.
+#version 330 core
+
+//Written once per frame through UniformBlock<BenchFrameData>.
+layout(std140) uniform BenchFrame
+{
+	mat4 transform;
+	vec3 color;
+	//Seconds since the first frame.
+	float time;
+	vec2 viewport;
+	//Tint of the four corners of every quad.
+	vec4 cornerColors[4];
+};
+
+//Scales the unit quad and moves it into place, xy: offset, z: scale.
+vec4 placeQuad(vec2 position, vec3 offsetScale)
+{
+	return vec4(position * offsetScale.z + offsetScale.xy, 0.0, 1.0);
+}
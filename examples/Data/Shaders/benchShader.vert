@@ -0,0 +1,47 @@
+/*
+BSD 2-Clause License
+Copyright (c) 2017, Davood Rasti and Alireza Rasti - rastisoft
+All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#version 330 core
+#include "benchCommon.glsl"
+
+layout(location = 0) in vec2 position;
+layout(location = 1) in vec2 uv;
+#ifdef INSTANCED
+//Per instance, xy: offset, z: scale.
+layout(location = 2) in vec3 offsetScale;
+#else
+//xy: offset, z: scale.
+uniform vec3 offsetScale;
+#endif
+out vec2 fragUV;
+out vec4 fragColor;
+
+//Only the uniforms scene changes it per draw.
+uniform mat4 drawTransform = mat4(1.0);
+
+void main()
+{
+	fragUV = uv;
+	fragColor = cornerColors[gl_VertexID % 4];
+	gl_Position = transform * drawTransform * placeQuad(position, offsetScale);
+}
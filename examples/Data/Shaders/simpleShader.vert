@@ -23,8 +23,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #version 330 core
 
-in vec4 position;
-in vec2 uv;
+layout(location = 0) in vec4 position;
+layout(location = 1) in vec2 uv;
 out vec2 fragUV;
 
 void main()
@@ -0,0 +1,335 @@
+/*
+BSD 2-Clause License
+Copyright (c) 2017, Davood Rasti and Alireza Rasti - rastisoft
+All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "BenchApp.h"
+#include <RS/Graphics/BaseGL/VertexArray.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+using namespace RS;
+using namespace RS::Graphics::BaseGL;
+
+namespace
+{
+    constexpr ui32 churnTextureSize{64};
+}
+
+BenchApp::BenchApp(const BenchSettings& settings) :
+    mSettings(settings)
+{
+}
+
+BenchApp::~BenchApp(void)
+{
+}
+
+void  BenchApp::initialize(void)
+{
+    mConfigParameters.set("windowTitle", "BaseGL benchmark");
+    mConfigParameters.set("screen.width", 512);
+    mConfigParameters.set("screen.height", 512);
+    mConfigParameters.set("context.headless", true);
+    mConfigParameters.set("context.api", mSettings.contextAPI);
+    mConfigParameters.set("run.maxFrames", mSettings.frames);
+    mConfigParameters.set("update.rate", 0);
+    mConfigParameters.set("profiler.gpu", true);
+
+    BaseGLApp::initialize();
+
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glClearColor(0.2f, 0.2f, 0.2f, 1.0f);
+
+    mFrameBlock = std::make_unique<UniformBlock<BenchFrameData>>(frameBlockBindingPoint);
+
+    if(mSettings.scene == BenchScene::Churn)
+    {
+        mChurnVertexShaderCode = mShaderPreprocessor.load("../Data/Shaders/benchShader.vert");
+        mChurnFragmentShaderCode = mShaderPreprocessor.load("../Data/Shaders/benchShader.frag");
+        mChurnPixels.resize(churnTextureSize * churnTextureSize * 4);
+        for(ui32 index = 0; index < mChurnPixels.size(); ++index)
+            mChurnPixels[index] = static_cast<ui8>(index % 4 == 3 ? 255 : index / 4);
+
+        mChurnShaders.resize(churnVariantCount);
+        mShaders.resize(churnVariantCount);
+        mUniforms.resize(churnVariantCount);
+        mTextures.resize(churnVariantCount);
+        for(ui32 slot = 0; slot < churnVariantCount; ++slot)
+            createChurnVariant(slot);
+    }
+    else
+    {
+        mShaderVariant = std::make_unique<ShaderVariant>(mShaderPreprocessor, "../Data/Shaders/benchShader.vert", "../Data/Shaders/benchShader.frag",
+                                                         std::vector<std::string>{"INSTANCED", "NO_OP"}, &mProgramBinaryCache);
+        mShaderVariant->precompileManifest("../Data/Shaders/bench.variants");
+
+        const bool isInstanced = (mSettings.scene == BenchScene::Instanced);
+        mShaders.push_back(&mShaderVariant->get(isInstanced ? mShaderVariant->getMask({"INSTANCED"}) : 0));
+        mUniforms.push_back(setupShader(*mShaders.back()));
+
+        mTextures.push_back(std::make_unique<Texture>("../Data/Images/hello_world.png"));
+        mTextures.back()->loadToGPU();
+    }
+
+    constexpr GLfloat verticesBufferData[] = { 
+        -1.0f, -1.0f, 0.0f, 1.0f,
+        1.0f, -1.0f, 1.0f, 1.0f,
+        -1.0f,  1.0f, 0.0f, 0.0f,
+        1.0f, 1.0f, 1.0f, 0.0f
+    };
+
+    constexpr GLushort indicesBufferData[] = {0, 1, 3, 0, 3, 2};
+    
+    mVBO = std::make_unique<Buffer<f32>>(GL_ARRAY_BUFFER);
+    mVBO->set(verticesBufferData, sizeof(verticesBufferData));
+
+    mIBO = std::make_unique<Buffer<ui16>>(GL_ELEMENT_ARRAY_BUFFER);
+    mIBO->set(indicesBufferData, sizeof(indicesBufferData));
+
+    if(mSettings.scene == BenchScene::Stream)
+    {
+        //The N quads are baked into the vertices, the rest up to X MB repeats them.
+        const size_t vertexCount = std::max<size_t>(static_cast<size_t>(mSettings.streamMegabytes * 1024.0f * 1024.0f) / sizeof(BenchVertex),
+                                                    mSettings.count * 4);
+        mStreamData.resize(vertexCount);
+        for(size_t vertex = 0; vertex < vertexCount; ++vertex)
+        {
+            f32 offsetScale[3];
+            getQuadOffsetScale(static_cast<ui32>((vertex / 4) % std::max<ui32>(mSettings.count, 1)), offsetScale);
+            const GLfloat* quadVertex = verticesBufferData + (vertex % 4) * 4;
+            mStreamData[vertex] = {{quadVertex[0] * offsetScale[2] + offsetScale[0], quadVertex[1] * offsetScale[2] + offsetScale[1]},
+                                   {quadVertex[2], quadVertex[3]}};
+        }
+
+        mStreamBuffer = std::make_unique<StreamBuffer>(GL_ARRAY_BUFFER, static_cast<ui32>(vertexCount * sizeof(BenchVertex)));
+        mStreamVertexArray = std::make_unique<VertexArray>();
+        mStreamVertexArray->addVertexBuffer<BenchVertexLayout>(mStreamBuffer->getHandle());
+        mStreamVertexArray->setIndexBuffer(*mIBO);
+    }
+
+    if(mSettings.scene == BenchScene::Instanced)
+    {
+        mInstanceData.resize(mSettings.count);
+        for(ui32 index = 0; index < mSettings.count; ++index)
+            getQuadOffsetScale(index, mInstanceData[index].offsetScale);
+
+        mInstanceBuffer = std::make_unique<Buffer<BenchInstance>>(GL_ARRAY_BUFFER, BufferUsage::Stream);
+        mInstanceBuffer->set(mInstanceData.data(), mInstanceData.size() * sizeof(BenchInstance));
+
+        mInstancedVertexArray = std::make_unique<VertexArray>();
+        mInstancedVertexArray->addVertexBuffer<BenchVertexLayout>(*mVBO);
+        mInstancedVertexArray->addVertexBuffer<BenchInstanceLayout>(*mInstanceBuffer);
+        mInstancedVertexArray->setIndexBuffer(*mIBO);
+    }
+}
+
+void  BenchApp::bindQuad(void)
+{
+    mVertexArrayCache.get<BenchVertexLayout>(*mVBO, *mIBO).bind();
+}
+
+void  BenchApp::createChurnVariant(ui32 slot)
+{
+    //The replaced program and texture are released through the deletion queue.
+    if(mShaders[slot])
+    {
+        mIssuedUniformCount += mShaders[slot]->getIssuedUniformCount();
+        mSkippedUniformCount += mShaders[slot]->getSkippedUniformCount();
+    }
+
+    auto shader = std::make_unique<Shader>();
+    shader->compileAndLink(mChurnVertexShaderCode, mChurnFragmentShaderCode, &mProgramBinaryCache);
+    mUniforms[slot] = setupShader(*shader);
+    mChurnShaders[slot] = std::move(shader);
+    mShaders[slot] = mChurnShaders[slot].get();
+
+    mTextures[slot] = std::make_unique<Texture>();
+    mTextures[slot]->bind();
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, churnTextureSize, churnTextureSize, 0, GL_RGBA, GL_UNSIGNED_BYTE, mChurnPixels.data());
+}
+
+BenchUniforms BenchApp::setupShader(Shader& shader)
+{
+    mFrameBlock->attach(shader, "BenchFrame");
+    return {shader.addUniform("offsetScale"),
+            shader.addUniform("drawColor"),
+            shader.addUniform("drawTransform"),
+            shader.addUniform("textureSampler")};
+}
+
+void  BenchApp::updateFrameBlock(double elapsedTime)
+{
+    static constexpr f32 identity[] = {1.0f, 0.0f, 0.0f, 0.0f,
+                                       0.0f, 1.0f, 0.0f, 0.0f,
+                                       0.0f, 0.0f, 1.0f, 0.0f,
+                                       0.0f, 0.0f, 0.0f, 1.0f};
+    static constexpr f32 cornerColors[4][4] = {{1.0f, 1.0f, 1.0f, 1.0f},
+                                               {1.0f, 0.9f, 0.9f, 1.0f},
+                                               {0.9f, 1.0f, 0.9f, 1.0f},
+                                               {0.9f, 0.9f, 1.0f, 1.0f}};
+
+    mTime += elapsedTime / 1000.0;
+
+    //One buffer write per frame shared by every program, instead of per-program uniform calls.
+    auto& frame = mFrameBlock->edit();
+    std::copy(std::begin(identity), std::end(identity), frame.transform);
+    frame.color[0] = frame.color[1] = frame.color[2] = 1.0f;
+    frame.time = static_cast<f32>(mTime);
+    frame.viewport[0] = static_cast<f32>(mScreenWidth);
+    frame.viewport[1] = static_cast<f32>(mScreenHeight);
+    std::memcpy(frame.cornerColors, cornerColors, sizeof(cornerColors));
+    mFrameBlock->upload();
+    mFrameBlock->bind();
+}
+
+void  BenchApp::getQuadOffsetScale(ui32 index, f32* offsetScale)
+{
+    //Spreads the quads over the screen.
+    const ui32 columns = static_cast<ui32>(std::ceil(std::sqrt(static_cast<f32>(mSettings.count))));
+    const f32 scale = 1.0f / columns;
+    offsetScale[0] = -1.0f + scale * (2 * (index % columns) + 1);
+    offsetScale[1] = -1.0f + scale * (2 * (index / columns) + 1);
+    offsetScale[2] = scale;
+}
+
+void  BenchApp::drawQuad(Shader& shader, const BenchUniforms& uniforms, ui32 index)
+{
+    f32 offsetScale[3];
+    getQuadOffsetScale(index, offsetScale);
+    shader.setUniform3f(uniforms.offsetScale, offsetScale[0], offsetScale[1], offsetScale[2]);
+
+    glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_SHORT, 0);
+}
+
+void  BenchApp::render(double elapsedTime, double)
+{
+    updateFrameBlock(elapsedTime);
+
+    if(mSettings.scene == BenchScene::Stream)
+    {
+        GPUProfileScope profileScope(mGPUProfiler, "stream");
+        const ui32 size = static_cast<ui32>(mStreamData.size() * sizeof(BenchVertex));
+        const auto allocation = mStreamBuffer->allocate(size, sizeof(BenchVertex));
+        std::memcpy(allocation.pointer, mStreamData.data(), size);
+        mStreamBuffer->flush();
+
+        auto& shader = *mShaders[0];
+        const auto& uniforms = mUniforms[0];
+        shader.use();
+        shader.setUniform1i(uniforms.textureSampler, 0);
+        //The positions are already placed.
+        shader.setUniform3f(uniforms.offsetScale, 0.0f, 0.0f, 1.0f);
+        mTextures[0]->activeAndBind(0);
+
+        mStreamVertexArray->bind();
+        const i32 firstVertex = static_cast<i32>(allocation.offset / sizeof(BenchVertex));
+        for(ui32 index = 0; index < mSettings.count; ++index)
+            glDrawElementsBaseVertex(GL_TRIANGLES, 6, GL_UNSIGNED_SHORT, nullptr, firstVertex + static_cast<i32>(index * 4));
+
+        mStreamBuffer->endFrame();
+        return;
+    }
+
+    if(mSettings.scene == BenchScene::Instanced)
+    {
+        auto& shader = *mShaders[0];
+        const auto& uniforms = mUniforms[0];
+        shader.use();
+        shader.setUniform1i(uniforms.textureSampler, 0);
+        mTextures[0]->activeAndBind(0);
+
+        mInstanceBuffer->stream(mInstanceData.data(), mInstanceData.size() * sizeof(BenchInstance));
+        mInstancedVertexArray->drawElementsInstanced(GL_TRIANGLES, 6, mSettings.count);
+        return;
+    }
+
+    bindQuad();
+
+    if(mSettings.scene == BenchScene::Churn)
+    {
+        createChurnVariant(mChurnFrame++ % churnVariantCount);
+
+        for(ui32 index = 0; index < mSettings.count; ++index)
+        {
+            auto& shader = *mShaders[index % churnVariantCount];
+            const auto& uniforms = mUniforms[index % churnVariantCount];
+            shader.use();
+            shader.setUniform1i(uniforms.textureSampler, 0);
+            mTextures[(index / 2) % churnVariantCount]->activeAndBind(0);
+            drawQuad(shader, uniforms, index);
+        }
+        return;
+    }
+
+    auto& shader = *mShaders[0];
+    const auto& uniforms = mUniforms[0];
+    shader.use();
+    shader.setUniform1i(uniforms.textureSampler, 0);
+    mTextures[0]->activeAndBind(0);
+
+    for(ui32 index = 0; index < mSettings.count; ++index)
+    {
+        if(mSettings.scene == BenchScene::Uniforms)
+        {
+            const f32 value = static_cast<f32>(index) / mSettings.count;
+            GLfloat transform[16] = {};
+            transform[0] = transform[5] = 1.0f - 0.5f * value;
+            transform[10] = transform[15] = 1.0f;
+
+            shader.setUniform3f(uniforms.drawColor, value, 1.0f - value, 0.5f);
+            shader.setUniformMatrix4fv(uniforms.drawTransform, transform);
+        }
+
+        drawQuad(shader, uniforms, index);
+    }
+}
+
+void  BenchApp::shutdown(void)
+{
+    for(const auto& shader : mShaders)
+    {
+        mIssuedUniformCount += shader->getIssuedUniformCount();
+        mSkippedUniformCount += shader->getSkippedUniformCount();
+    }
+
+    if(mShaderVariant)
+    {
+        mShaderVariantCount = mShaderVariant->getVariantCount();
+        mShaderProgramCount = mShaderVariant->getProgramCount();
+    }
+
+    mFrameBlock.reset();
+    mStreamVertexArray.reset();
+    mStreamBuffer.reset();
+    mInstancedVertexArray.reset();
+    mInstanceBuffer.reset();
+    mVertexArrayCache.remove(mVBO->getHandle());
+    mIBO.reset();
+    mVBO.reset();
+    mTextures.clear();
+    mUniforms.clear();
+    mShaders.clear();
+    mChurnShaders.clear();
+    mShaderVariant.reset();
+}
@@ -0,0 +1,184 @@
+/*
+BSD 2-Clause License
+Copyright (c) 2017, Davood Rasti and Alireza Rasti - rastisoft
+All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "RS/Graphics/BaseGL/BaseGLApp.h"
+#include "RS/Graphics/BaseGL/ShaderPreprocessor.h"
+#include "RS/Graphics/BaseGL/ShaderVariant.h"
+#include "RS/Graphics/BaseGL/StreamBuffer.h"
+#include "RS/Graphics/BaseGL/UniformBlock.h"
+#include "RS/Graphics/BaseGL/VertexLayout.h"
+#include <string>
+#include <vector>
+
+using namespace RS::Graphics;
+
+enum class BenchScene
+{
+    //N textured quads, one draw each, only their position changes.
+    Quads,
+    //N draws that each set several unique uniforms.
+    Uniforms,
+    //Streams X MB of vertex data per frame through a StreamBuffer and draws N quads from it.
+    Stream,
+    //N draws that switch program and texture on every draw, one program and texture are recreated per frame.
+    Churn,
+    //N quads in one instanced draw, the instance data is uploaded every frame.
+    Instanced
+};
+
+struct BenchVertex
+{
+    RS::f32                     position[2];
+    RS::f32                     uv[2];
+};
+
+struct BenchInstance
+{
+    RS::f32                     offsetScale[3];
+};
+
+using BenchVertexLayout = BaseGL::VertexLayout<BenchVertex,
+                                               BaseGL::VertexAttribute<0, RS::f32, 2>,
+                                               BaseGL::VertexAttribute<1, RS::f32, 2>>;
+RS_VERTEX_ATTRIBUTE(BenchVertexLayout, 0, position);
+RS_VERTEX_ATTRIBUTE(BenchVertexLayout, 1, uv);
+//Mirrors the std140 block BenchFrame of benchCommon.glsl, written once per frame.
+struct BenchFrameData
+{
+    RS::f32                     transform[16];
+    RS::f32                     color[3];
+    //Packed into the last component of color.
+    RS::f32                     time;
+    RS::f32                     viewport[2];
+    RS::f32                     padding[2];
+    RS::f32                     cornerColors[4][4];
+};
+RS_STD140_MEMBER(BenchFrameData, transform, Mat4);
+RS_STD140_MEMBER(BenchFrameData, color, Vec3);
+RS_STD140_MEMBER(BenchFrameData, time, Float);
+RS_STD140_MEMBER(BenchFrameData, viewport, Vec2);
+RS_STD140_ARRAY(BenchFrameData, cornerColors, Vec4, 4);
+static_assert(sizeof(BenchFrameData) % 16 == 0, "BenchFrameData must be padded to vec4.");
+
+struct BenchUniforms
+{
+    BaseGL::UniformHandle       offsetScale;
+    BaseGL::UniformHandle       drawColor;
+    BaseGL::UniformHandle       drawTransform;
+    BaseGL::UniformHandle       textureSampler;
+};
+
+using BenchInstanceLayout = BaseGL::VertexLayout<BenchInstance, BaseGL::InstanceAttribute<2, RS::f32, 3>>;
+RS_VERTEX_ATTRIBUTE(BenchInstanceLayout, 0, offsetScale);
+
+struct BenchSettings
+{
+    BenchScene                  scene{BenchScene::Quads};
+    RS::ui32                    count{1000};
+    RS::ui32                    frames{500};
+    RS::f32                     streamMegabytes{4.0f};
+    std::string                 contextAPI{"native"};
+};
+
+class BenchApp : public BaseGL::BaseGLApp
+{
+private:
+    static constexpr RS::ui32   churnVariantCount{8};
+    static constexpr RS::ui32   frameBlockBindingPoint{0};
+
+    BenchSettings               mSettings;
+
+    BaseGL::ShaderPreprocessor  mShaderPreprocessor;
+    //Variants of the bench shaders, the churn scene builds its own programs instead.
+    BaseGL::UPT<BaseGL::ShaderVariant>          mShaderVariant;
+    std::vector<BaseGL::UPT<BaseGL::Shader>>    mChurnShaders;
+    //The programs in use, from mShaderVariant or mChurnShaders.
+    std::vector<BaseGL::Shader*>                mShaders;
+    //The uniform handles of mShaders.
+    std::vector<BenchUniforms>                  mUniforms;
+    std::vector<BaseGL::TextureUPT>             mTextures;
+    BaseGL::UPT<BaseGL::UniformBlock<BenchFrameData>> mFrameBlock;
+    //Seconds since the first frame.
+    double                      mTime{0.0};
+    BaseGL::BufferUPT<RS::f32>  mVBO;
+    BaseGL::BufferUPT<RS::ui16> mIBO;
+    BaseGL::UPT<BaseGL::StreamBuffer> mStreamBuffer;
+    //X MB of vertices, the first N quads of it are drawn.
+    std::vector<BenchVertex>    mStreamData;
+    BaseGL::VertexArrayUPT      mStreamVertexArray;
+    //Sources and pixels the churn variants are recreated from.
+    std::string                 mChurnVertexShaderCode;
+    std::string                 mChurnFragmentShaderCode;
+    std::vector<RS::ui8>        mChurnPixels;
+    RS::ui32                    mChurnFrame{0};
+    BaseGL::BufferUPT<BenchInstance> mInstanceBuffer;
+    std::vector<BenchInstance>  mInstanceData;
+    BaseGL::VertexArrayUPT      mInstancedVertexArray;
+    //Uniform setter calls of all programs, collected before they are destroyed.
+    RS::ui64                    mIssuedUniformCount{0};
+    RS::ui64                    mSkippedUniformCount{0};
+    //Collected before mShaderVariant is destroyed.
+    RS::ui32                    mShaderVariantCount{0};
+    RS::ui32                    mShaderProgramCount{0};
+
+    void                        bindQuad(void);
+    void                        createChurnVariant(RS::ui32 slot);
+    //Registers the uniforms of a program and attaches it to the frame block.
+    BenchUniforms               setupShader(BaseGL::Shader& shader);
+    void                        updateFrameBlock(double elapsedTime);
+    void                        drawQuad(BaseGL::Shader& shader, const BenchUniforms& uniforms, RS::ui32 index);
+    void                        getQuadOffsetScale(RS::ui32 index, RS::f32* offsetScale);
+
+public:
+                                BenchApp(const BenchSettings& settings);
+    virtual                     ~BenchApp(void);
+
+    void                        initialize(void) final;
+    void                        render(double elapsedTime, double interpolationAlpha) final;
+    void                        shutdown(void) final;
+
+    RS::ui64                    getIssuedUniformCount(void) const noexcept;
+    RS::ui64                    getSkippedUniformCount(void) const noexcept;
+    RS::ui32                    getShaderVariantCount(void) const noexcept;
+    RS::ui32                    getShaderProgramCount(void) const noexcept;
+};
+
+RS_INLINE RS::ui64 BenchApp::getIssuedUniformCount(void) const noexcept
+{
+    return mIssuedUniformCount;
+}
+
+RS_INLINE RS::ui64 BenchApp::getSkippedUniformCount(void) const noexcept
+{
+    return mSkippedUniformCount;
+}
+
+RS_INLINE RS::ui32 BenchApp::getShaderVariantCount(void) const noexcept
+{
+    return mShaderVariantCount;
+}
+
+RS_INLINE RS::ui32 BenchApp::getShaderProgramCount(void) const noexcept
+{
+    return mShaderProgramCount;
+}
\ No newline at end of file
@@ -0,0 +1,146 @@
+/*
+BSD 2-Clause License
+Copyright (c) 2017, Davood Rasti and Alireza Rasti - rastisoft
+All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "BenchApp.h"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+
+using namespace RS;
+using namespace std::chrono;
+
+namespace
+{
+    const char* sceneNames[] = {"quads", "uniforms", "stream", "churn", "instanced"};
+    constexpr i32 sceneCount = sizeof(sceneNames) / sizeof(sceneNames[0]);
+
+    void printUsage(void)
+    {
+        std::cerr << "usage: basegl_bench [--scene=quads|uniforms|stream|churn|instanced|all] [--count=N] [--frames=N]\n"
+                     "                    [--stream-mb=X] [--api=native|egl|osmesa]\n";
+    }
+
+    //Prints the result of a scene as a single JSON line.
+    void runScene(BenchSettings settings)
+    {
+        BenchApp benchApp(settings);
+        benchApp.initialize();
+
+        const auto startTime = steady_clock::now();
+        benchApp.run();
+        const double totalTime = duration<double>(steady_clock::now() - startTime).count();
+
+        const auto statistics = benchApp.getFrameStatistics();
+        f32 gpuFrameTime{0.0f};
+        for(const auto& scope : statistics.gpuScopes)
+        {
+            if(scope.name == "frame")
+                gpuFrameTime = scope.avgTime;
+        }
+
+        std::cout << std::fixed << std::setprecision(3)
+                  << "{\"scene\":\"" << sceneNames[static_cast<i32>(settings.scene)] << "\""
+                  << ",\"count\":" << settings.count
+                  << ",\"frames\":" << settings.frames
+                  << ",\"fps\":" << settings.frames / totalTime
+                  << ",\"render_ms\":" << statistics.renderTime.avg
+                  << ",\"render_ms_p99\":" << statistics.renderTime.p99
+                  << ",\"frame_ms\":" << statistics.frameTime.avg
+                  << ",\"frame_ms_p99\":" << statistics.frameTime.p99
+                  << ",\"gpu_ms\":" << gpuFrameTime
+                  << ",\"pacer_jitter_ms_p99\":" << statistics.pacerJitter.p99
+                  << ",\"missed_deadlines\":" << statistics.missedDeadlineCount
+                  << ",\"uniforms_issued\":" << benchApp.getIssuedUniformCount()
+                  << ",\"uniforms_skipped\":" << benchApp.getSkippedUniformCount()
+                  << ",\"shader_variants\":" << benchApp.getShaderVariantCount()
+                  << ",\"shader_programs\":" << benchApp.getShaderProgramCount()
+                  << "}" << std::endl;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    BenchSettings settings;
+    std::string sceneName{"all"};
+
+    for(i32 index = 1; index < argc; ++index)
+    {
+        const std::string argument(argv[index]);
+        const auto separator = argument.find('=');
+        const std::string key = argument.substr(0, separator);
+        const std::string value = (separator == std::string::npos) ? "" : argument.substr(separator + 1);
+
+        try
+        {
+            if(key == "--scene")
+                sceneName = value;
+            else if(key == "--count")
+                settings.count = std::stoul(value);
+            else if(key == "--frames")
+                settings.frames = std::stoul(value);
+            else if(key == "--stream-mb")
+                settings.streamMegabytes = std::stof(value);
+            else if(key == "--api")
+                settings.contextAPI = value;
+            else
+            {
+                printUsage();
+                return 1;
+            }
+        }
+        //std::stoul/std::stof throw for values that are not numbers or out of range.
+        catch(const std::logic_error&)
+        {
+            printUsage();
+            return 1;
+        }
+    }
+
+    try
+    {
+        bool isSceneFound{false};
+        for(i32 scene = 0; scene < sceneCount; ++scene)
+        {
+            if(sceneName != "all" && sceneName != sceneNames[scene])
+                continue;
+
+            settings.scene = static_cast<BenchScene>(scene);
+            runScene(settings);
+            isSceneFound = true;
+        }
+
+        if(!isSceneFound)
+        {
+            printUsage();
+            return 1;
+        }
+    }
+    catch(const std::exception& exception)
+    {
+        std::cerr << exception.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -23,6 +23,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "SimpleApp.h"
 #include <RS/Graphics/BaseGL/Buffer.h>
+#include <RS/Graphics/BaseGL/VertexArray.h>
 
 using namespace RS;
 using namespace RS::Graphics::BaseGL;
@@ -51,47 +52,45 @@ void  SimpleApp::initialize(void)
 
     mShader.loadCompileAndLink("../Data/Shaders/simpleShader.vert", "../Data/Shaders/simpleShader.frag");
 
-    mPositionLocation = mShader.getAttribLocation("position");
-    mUVLocation = mShader.getAttribLocation("uv");
     mTextureLocation = mShader.getUniformLocation("textureSampler");
 
-    constexpr GLfloat verticesBufferData[] = { 
-        -1.0f, -1.0f, 0.0f, 1.0f,
-        1.0f, -1.0f, 1.0f, 1.0f,
-        -1.0f,  1.0f, 0.0f, 0.0f,
-        1.0f, 1.0f, 1.0f, 0.0f
+    constexpr SimpleVertex verticesBufferData[] = { 
+        {{-1.0f, -1.0f}, {0.0f, 1.0f}},
+        {{1.0f, -1.0f}, {1.0f, 1.0f}},
+        {{-1.0f,  1.0f}, {0.0f, 0.0f}},
+        {{1.0f, 1.0f}, {1.0f, 0.0f}}
     };
 
     constexpr GLushort indicesBufferData[] = {0, 1, 3, 0, 3, 2};
     
-    mVBO = std::make_unique<Buffer<f32>>(GL_ARRAY_BUFFER);
+    mVBO = std::make_unique<Buffer<SimpleVertex>>(GL_ARRAY_BUFFER);
     mVBO->set(verticesBufferData, sizeof(verticesBufferData));
 
     mIBO = std::make_unique<Buffer<ui16>>(GL_ELEMENT_ARRAY_BUFFER);
     mIBO->set(indicesBufferData, sizeof(indicesBufferData));
 
+    mVertexArray = std::make_unique<VertexArray>();
+    mVertexArray->addVertexBuffer<SimpleVertexLayout>(*mVBO);
+    mVertexArray->setIndexBuffer(*mIBO);
+    mVertexArray->unbind();
+
     mBackgroundTexture = std::make_unique<Texture>("../Data/Images/hello_world.png");
     mBackgroundTexture->loadToGPU();
 
 }
 
-void  SimpleApp::render(double elapsedTime)
+void  SimpleApp::render(double, double)
 {
     mShader.use();
-    mVBO->bind();
-    mIBO->bind();
-    
-    glEnableVertexAttribArray(mPositionLocation);
-    glVertexAttribPointer(mPositionLocation, 2, GL_FLOAT, GL_FALSE, 16, 0);
-    
-    glEnableVertexAttribArray(mUVLocation);
-    glVertexAttribPointer(mUVLocation, 2, GL_FLOAT, GL_FALSE, 16, (void*)(8));        
+    mVertexArray->bind();
     
-    glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_SHORT, 0);
-
-    glDisableVertexAttribArray(mPositionLocation);
-    glDisableVertexAttribArray(mUVLocation);
+    glDrawElements(GL_TRIANGLES, 6, mVertexArray->getIndexType(), 0);
+}
 
-    mVBO->unbind();
-    mIBO->unbind();
+void  SimpleApp::shutdown(void)
+{
+    mBackgroundTexture.reset();
+    mVertexArray.reset();
+    mIBO.reset();
+    mVBO.reset();
 }
\ No newline at end of file
@@ -22,28 +22,41 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */ 
 
 #include "RS/Graphics/BaseGL/BaseGLApp.h"
+#include "RS/Graphics/BaseGL/VertexLayout.h"
 #include <iostream>
 
 using namespace RS::Graphics;
 
+struct SimpleVertex
+{
+    RS::f32                     position[2];
+    RS::f32                     uv[2];
+};
+
+using SimpleVertexLayout = BaseGL::VertexLayout<SimpleVertex,
+                                                BaseGL::VertexAttribute<0, RS::f32, 2>,
+                                                BaseGL::VertexAttribute<1, RS::f32, 2>>;
+RS_VERTEX_ATTRIBUTE(SimpleVertexLayout, 0, position);
+RS_VERTEX_ATTRIBUTE(SimpleVertexLayout, 1, uv);
+
 class SimpleApp : public BaseGL::BaseGLApp
 {
 private:
     GLuint                      mTextureHandle;
     BaseGL::Shader              mShader;
 
-    BaseGL::BufferUPT<RS::f32>  mVBO;
+    BaseGL::BufferUPT<SimpleVertex> mVBO;
     BaseGL::BufferUPT<RS::ui16> mIBO;
+    BaseGL::VertexArrayUPT      mVertexArray;
 
     BaseGL::TextureUPT          mBackgroundTexture;
 
-    GLint                       mPositionLocation;
-    GLint                       mUVLocation;
     GLint                       mTextureLocation;
 public:
                                 SimpleApp(void);
     virtual                     ~SimpleApp(void);
 
     void                        initialize(void) final;
-    void                        render(double elapsedTime) final;
+    void                        render(double elapsedTime, double interpolationAlpha) final;
+    void                        shutdown(void) final;
 };
\ No newline at end of file
@@ -49,6 +49,12 @@ namespace RS
         BGL_CreatingShaderProgramFailed,
         BGL_CreatingShaderFailed,
         BGL_CompilingShaderFailed,
-        BGL_ShaderAddUniformFailed
+        BGL_ShaderAddUniformFailed,
+        BGL_FrameBufferIncomplete,
+        BGL_StreamBufferOverflow,
+        BGL_MappingBufferFailed,
+        BGL_ShaderIncludeFailed,
+        BGL_ShaderVariantUnknownDefine,
+        BGL_ContextAPINotSupported
     };
 }
\ No newline at end of file
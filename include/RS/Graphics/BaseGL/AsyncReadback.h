@@ -0,0 +1,135 @@
+/*
+BSD 2-Clause License
+Copyright (c) 2017, Davood Rasti and Alireza Rasti - rastisoft
+All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#pragma once
+
+#include <GL/glew.h>
+#include <functional>
+#include <future>
+#include <vector>
+#include "RS/Common/CommonTypes.h"
+
+namespace RS::Graphics::BaseGL
+{
+    /**
+        @description: Reads GPU data back without stalling the pipeline. A request copies the data into
+        a pixel pack buffer of a ring and places a fence after the copy; poll() maps the buffers whose
+        fence has signalled, usually a few frames later, and completes their requests in order.
+        Requests must be made and polled on the thread that owns the context. BaseGLApp polls its
+        readback at the end of every frame, so a future must not be waited for in the same frame on
+        that thread.
+    */
+    class AsyncReadback
+    {
+    public:
+        //Receives the data and its size in bytes, the data is valid only during the call.
+        //It runs inside poll() and must not make new requests.
+        typedef std::function<void(const ui8* data, ui32 size)> Callback;
+
+    protected:
+        struct ReadbackSlot
+        {
+            GLuint                  buffer{0};
+            ui32                    capacity{0};
+            ui32                    size{0};
+            GLsync                  fence{nullptr};
+            Callback                callback;
+        };
+
+        std::vector<ReadbackSlot>   mSlots;
+        //The oldest pending slot and the number of pending slots.
+        ui32                        mHeadIndex{0};
+        ui32                        mPendingCount{0};
+        ui64                        mStallCount{0};
+        bool                        mIsPolling{false};
+
+        ReadbackSlot&               acquireSlot(ui32 size);
+        void                        complete(ReadbackSlot& slot);
+        static ui32                 getPixelSize(GLenum format, GLenum type);
+
+    public:
+        /**
+            @description: AsyncReadback constructor. The buffers are created on first use.
+            @param slotCount: the number of requests that may be pending at once.
+            @return
+        */
+                                    AsyncReadback(ui32 slotCount = 4);
+                                    AsyncReadback(const AsyncReadback&) = delete;
+        AsyncReadback&              operator=(const AsyncReadback&) = delete;
+        virtual                     ~AsyncReadback(void);
+
+        /**
+            @description: Reads a rectangle of the read framebuffer. The rows are tightly packed.
+            @param x, y, width, height: the rectangle.
+            @param format: the pixel format.(e.g. GL_RGBA, GL_RED_INTEGER, GL_DEPTH_COMPONENT)
+            @param type: the component type.(e.g. GL_UNSIGNED_BYTE, GL_FLOAT)
+            @param callback: called by poll() with the pixels.
+            @return void.
+        */
+        void                        readPixels(i32 x, i32 y, i32 width, i32 height, GLenum format, GLenum type, Callback callback);
+        std::future<std::vector<ui8>> readPixels(i32 x, i32 y, i32 width, i32 height, GLenum format, GLenum type);
+
+        /**
+            @description: Reads a range of a buffer object.
+            @param buffer: the buffer name.
+            @param offset: the byte offset of the range.
+            @param size: the size of the range in bytes.
+            @param callback: called by poll() with the data.
+            @return void.
+        */
+        void                        readBuffer(GLuint buffer, ui32 offset, ui32 size, Callback callback);
+        std::future<std::vector<ui8>> readBuffer(GLuint buffer, ui32 offset, ui32 size);
+
+        /**
+            @description: Completes the requests whose data has arrived, oldest first. It never waits.
+            @return void.
+        */
+        void                        poll(void);
+
+        /**
+            @description: Deletes the buffers and fences. Pending requests are dropped, their futures
+            get std::future_error(broken_promise).
+            @return void.
+        */
+        void                        releaseBuffers(void);
+
+        ui32                        getPendingCount(void) const noexcept;
+
+        /**
+            @description: Returns how many times a request had to wait for the oldest one because
+            all the slots were pending.(More slots or fewer requests per frame avoid it)
+            @return ui64.
+        */
+        ui64                        getStallCount(void) const noexcept;
+    };
+
+    RS_INLINE ui32 AsyncReadback::getPendingCount(void) const noexcept
+    {
+        return mPendingCount;
+    }
+
+    RS_INLINE ui64 AsyncReadback::getStallCount(void) const noexcept
+    {
+        return mStallCount;
+    }
+}
\ No newline at end of file
@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 namespace RS::Graphics::BaseGL
 {
     class Texture;
+    class FrameBuffer;
+    class VertexArray;
     class Model;
 
     template<class T> class Buffer;
@@ -37,6 +39,8 @@ namespace RS::Graphics::BaseGL
 
     typedef UPT<Texture> TextureUPT;
     typedef UPT<Model> ModelUPT;
+    typedef UPT<FrameBuffer> FrameBufferUPT;
+    typedef UPT<VertexArray> VertexArrayUPT;
     
     template<class T> using BufferUPT = UPT<Buffer<T>>;
 }
\ No newline at end of file
@@ -23,10 +23,27 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
 #include "RS/Graphics/BaseGL/BaseGL.h"
+#include "RS/Graphics/BaseGL/AsyncReadback.h"
 #include "RS/Graphics/BaseGL/Texture.h"
 #include "RS/Graphics/BaseGL/Shader.h"
 #include "RS/Graphics/BaseGL/Buffer.h"
+#include "RS/Graphics/BaseGL/DeletionQueue.h"
+#include "RS/Graphics/BaseGL/FrameBuffer.h"
+#include "RS/Graphics/BaseGL/FramePacer.h"
+#include "RS/Graphics/BaseGL/FrameTimeRecorder.h"
+#include "RS/Graphics/BaseGL/GLStateCache.h"
+#include "RS/Graphics/BaseGL/GPUProfiler.h"
+#include "RS/Graphics/BaseGL/ProgramBinaryCache.h"
+#include "RS/Graphics/BaseGL/ShaderHotReloader.h"
+#include "RS/Graphics/BaseGL/TripleBuffer.h"
+#include "RS/Graphics/BaseGL/VertexArrayCache.h"
 #include "RS/Data/ParametersList/ParametersList.h"
 
 namespace RS::Graphics::BaseGL
@@ -46,17 +63,43 @@ namespace RS::Graphics::BaseGL
         //The ParameterList object that is used
         //to configure the application.
         Data::ParametersList        mConfigParameters;
-        f32                         mElapsedTimeLimit;
+        f32                         mElapsedTimeLimit{0.0f};
         //Stores the time that takes to render a frame.(in millisec)
         double                      mElapsedTime{0.0};
-        ui32                        mFPS{0};        
-        ui32                        mFPSLimit;
+        //Fixed update step and the time not simulated yet.(in millisec)
+        double                      mFixedDeltaTime{0.0};
+        double                      mUpdateAccumulator{0.0};
+        ui32                        mMaxUpdateStepsPerFrame{0};
+        std::atomic<ui32>           mFPS{0};        
+        ui32                        mFPSLimit{0};
+        //Limits the frame rate to mFPSLimit or to the monitor refresh rate.
+        FramePacer                  mFramePacer;
+        //Per-frame timings of the latest frames.
+        FrameTimeRecorder           mFrameTimeRecorder;
+        //GPU timings of the frame and of the scopes added by the application.
+        GPUProfiler                 mGPUProfiler;
+        //Binding state of the GL context, it is current on the thread that owns the context.
+        GLStateCache                mStateCache;
+        //Deletes released GL objects once the GPU is done with their frame.
+        DeletionQueue               mDeletionQueue;
+        //GPU to CPU transfers, polled at the end of every frame.
+        AsyncReadback               mAsyncReadback;
+        //On-disk program binaries.(see "shader.binaryCacheDirectory")
+        ProgramBinaryCache          mProgramBinaryCache;
+        //Rebuilds watched programs when their files change.(see "shader.hotReload")
+        ShaderHotReloader           mShaderHotReloader;
+        //Vertex arrays of the geometry drawn by the application, built on first use.
+        VertexArrayCache            mVertexArrayCache;
 
          //Screen resolution.
         i32                         mScreenWidth;
         i32                         mScreenHeight;
 
         bool                        mIsFullScreen{false};
+        //In headless mode the window is never shown and
+        //rendering goes to mOffscreenFrameBuffer.
+        bool                        mIsHeadless{false};
+        FrameBufferUPT              mOffscreenFrameBuffer;
 
         i32                         mViewPortX;
         i32                         mViewPortY;
@@ -67,6 +110,50 @@ namespace RS::Graphics::BaseGL
         i32                         mWindowHeight;
 
         MonitorInfo                 mMonitorInfo;
+
+        //Frame state handoff between the application thread and
+        //the render thread.(see "run.renderThread")
+        struct FrameSlotInfo
+        {
+            double                  interpolationAlpha{1.0};
+            f32                     pollTime{0.0f};
+            f32                     updateTime{0.0f};
+        };
+
+        bool                        mUseRenderThread{false};
+        std::thread                 mRenderThread;
+        std::array<FrameSlotInfo, 3> mFrameSlotInfo;
+        TripleBufferIndex           mFrameStateIndex;
+        ui32                        mRenderFrameSlot{0};
+        std::mutex                  mFrameHandoffMutex;
+        std::condition_variable     mFrameHandoffCondition;
+        ui64                        mPublishedFrameCount{0};
+        ui64                        mConsumedFrameCount{0};
+        bool                        mIsRenderThreadRunning{false};
+        std::exception_ptr          mRenderThreadException;
+
+        std::chrono::steady_clock::time_point   mLastFrameTime;
+        std::chrono::steady_clock::time_point   mFPSStartTime;
+        ui32                        mFramesDone{0};
+        ui64                        mFrameNumber{0};
+        ui64                        mMaxFrames{0};
+        ui32                        mFrameScopeId{0};
+
+        bool                        shouldClose(void);
+        void                        beginFrameClock(void);
+        double                      updateSimulation(double elapsedTime);
+        void                        renderFrame(double interpolationAlpha, FrameSample* frameSample);
+        bool                        finishFrame(FrameSample* frameSample);
+        void                        runSingleThreaded(void);
+        void                        runWithRenderThread(void);
+        void                        renderThreadLoop(void);
+
+        /**
+            @description: Returns the frame state slot (0, 1 or 2) that render() should read,
+            i.e. the latest slot completed by prepareFrame().
+            @return ui32.
+        */
+        ui32                        getRenderFrameSlot(void) const noexcept;
         
     public:
         static BaseGLApp*           baseGLAppInstance;
@@ -77,6 +164,10 @@ namespace RS::Graphics::BaseGL
         /**
             @description: Initializes the BaseGLApp. It uses mConfigParameters
             to configure openGL and other components of the application.
+            If "context.headless" is true, an invisible window is created
+            (using the context API named by "context.api": native, egl or osmesa)
+            and the scene is rendered into an offscreen framebuffer of
+            "screen.width" x "screen.height".
 
             @return void
         */
@@ -84,7 +175,8 @@ namespace RS::Graphics::BaseGL
         
         /**
             @description: Specifies the maximum FPS that scene should be rendered. If it is set to 0
-            the scene is rendered in maximum frame rate supported by hardware.          
+            the scene is rendered in maximum frame rate supported by hardware. If "screen.lockToRefreshRate"
+            is true, the frame rate is locked to the monitor refresh rate and this limit is ignored.
             @return void.
         */
         void                        setFPSLimit(ui32 fps);
@@ -102,17 +194,118 @@ namespace RS::Graphics::BaseGL
         */
         ui32                        getFPS(void) noexcept;
 
+        /**
+            @description: Returns true if the application renders offscreen without a visible window.
+            @return bool.
+        */
+        bool                        isHeadless(void) noexcept;
+
+        /**
+            @description: Returns the GPU profiler which is driven by run(). Scopes can be
+            profiled in render() by GPUProfileScope. It is enabled by "profiler.gpu".
+            @return GPUProfiler&.
+        */
+        GPUProfiler&                getGPUProfiler(void) noexcept;
+
+        /**
+            @description: Returns the binding state cache of the GL context. Its counters show how
+            many bind calls were issued and how many were skipped as redundant.
+            @return GLStateCache&.
+        */
+        GLStateCache&               getStateCache(void) noexcept;
+
+        /**
+            @description: Returns the queue that GL resources released by the application go to.
+            It is current on the application thread and on the render thread, the objects are
+            deleted at the end of the frame once the GPU has finished it.
+            @return DeletionQueue&.
+        */
+        DeletionQueue&              getDeletionQueue(void) noexcept;
+
+        /**
+            @description: Returns the asynchronous readback of the context. Requests can be made in
+            render(), their callbacks/futures complete at the end of a later frame on the thread
+            that renders.
+            @return AsyncReadback&.
+        */
+        AsyncReadback&              getAsyncReadback(void) noexcept;
+
+        /**
+            @description: Returns the program binary cache to pass to Shader::loadCompileAndLink().
+            Its directory is "shader.binaryCacheDirectory", the cache is disabled if it is empty.
+            @return ProgramBinaryCache&.
+        */
+        ProgramBinaryCache&         getProgramBinaryCache(void) noexcept;
+
+        /**
+            @description: Returns the shader hot reloader. Programs added by ShaderHotReloader::watch() are
+            swapped at the end of the frame after their files change. Files are watched while run() runs
+            if "shader.hotReload" is true, ShaderHotReloader::requestReload() works either way.
+            @return ShaderHotReloader&.
+        */
+        ShaderHotReloader&          getShaderHotReloader(void) noexcept;
+
+        /**
+            @description: Returns the vertex array cache, it is cleared after shutdown().
+            @return VertexArrayCache&.
+        */
+        VertexArrayCache&           getVertexArrayCache(void) noexcept;
+
+        /**
+            @description: Returns min/avg/p50/p95/p99/max of event polling, update(), render(), the FPS limiter,
+            buffer swapping, the frame-end housekeeping, the whole frame and the pacer jitter over the latest frames, along with
+            the missed pacer deadlines and the GPU time of the profiled scopes. It can be called from any thread.
+            @param frameCount: the number of latest frames to consider.(at most FrameTimeRecorder::capacity)
+            @return FrameStatistics.
+        */
+        FrameStatistics             getFrameStatistics(ui32 frameCount = FrameTimeRecorder::capacity) const;
+
         /**
             @description: Pure virtual function which should implement by child classes.
             This function is called by BaseGLApp class to render content. render()
             is pure virtual function which should implement by derived classes.
             @param elapsedTime: the time that takes to render a frame.(in millisec).
+            @param interpolationAlpha: how far the current time is between the last and the next
+            update() in [0, 1). It is used to interpolate the last two simulated states.
+            @return void.
+        */
+        virtual void                render(double elapsedTime, double interpolationAlpha) = 0;
+
+        /**
+            @description: Called by run() at the fixed rate of "update.rate" (in Hz) before render(),
+            as many times as needed to catch up with the real time, but at most "update.maxStepsPerFrame"
+            times per frame; the time beyond that is dropped. If "update.rate" is 0 it is never called.
+            @param fixedDeltaTime: the fixed time step.(in millisec).
             @return void.
         */
-        virtual void                render(double elapsedTime) = 0;
+        virtual void                update(double fixedDeltaTime);
 
         /**
-            @description: Starts the main render loop.            
+            @description: Called by run() after update() on the application thread. It should write
+            everything render() needs into the frame state slot frameSlot (one of three slots kept by
+            the application). If "run.renderThread" is true, render() runs on a dedicated thread that
+            owns the GL context and reads the latest completed slot (getRenderFrameSlot()) while the
+            next frame is prepared, so prepareFrame() must not make GL calls in that mode.
+            @param frameSlot: the slot to write, 0, 1 or 2.
+            @param interpolationAlpha: the same value that is passed to render() for this frame.
+            @return void.
+        */
+        virtual void                prepareFrame(ui32 frameSlot, double interpolationAlpha);
+
+        /**
+            @description: Called by run() after the last frame while the GL context is still
+            current. Derived classes should release their GL resources here.
+            @return void.
+        */
+        virtual void                shutdown(void);
+
+        /**
+            @description: Starts the main render loop. The loop ends when the window
+            is closed, ESC is pressed or "run.maxFrames" frames (if not 0) are rendered.
+            If "run.renderThread" is true, GL submission and buffer swapping run on a
+            dedicated thread and overlap with update()/prepareFrame() of the next frame; the
+            application may run up to one frame ahead of the render thread. An exception thrown by
+            update() or prepareFrame() stops the render thread before it leaves run().
             @return void.
         */
         virtual void                run(void);
@@ -137,4 +330,58 @@ namespace RS::Graphics::BaseGL
     {
         return mFPS;
     }
+
+    RS_INLINE ui32 BaseGLApp::getRenderFrameSlot(void) const noexcept
+    {
+        return mRenderFrameSlot;
+    }
+
+    RS_INLINE bool BaseGLApp::isHeadless(void) noexcept
+    {
+        return mIsHeadless;
+    }
+
+    RS_INLINE GPUProfiler& BaseGLApp::getGPUProfiler(void) noexcept
+    {
+        return mGPUProfiler;
+    }
+
+    RS_INLINE GLStateCache& BaseGLApp::getStateCache(void) noexcept
+    {
+        return mStateCache;
+    }
+
+    RS_INLINE DeletionQueue& BaseGLApp::getDeletionQueue(void) noexcept
+    {
+        return mDeletionQueue;
+    }
+
+    RS_INLINE AsyncReadback& BaseGLApp::getAsyncReadback(void) noexcept
+    {
+        return mAsyncReadback;
+    }
+
+    RS_INLINE ProgramBinaryCache& BaseGLApp::getProgramBinaryCache(void) noexcept
+    {
+        return mProgramBinaryCache;
+    }
+
+    RS_INLINE ShaderHotReloader& BaseGLApp::getShaderHotReloader(void) noexcept
+    {
+        return mShaderHotReloader;
+    }
+
+    RS_INLINE VertexArrayCache& BaseGLApp::getVertexArrayCache(void) noexcept
+    {
+        return mVertexArrayCache;
+    }
+
+    RS_INLINE FrameStatistics BaseGLApp::getFrameStatistics(ui32 frameCount) const
+    {
+        auto statistics = mFrameTimeRecorder.getStatistics(frameCount);
+        statistics.missedDeadlineCount = mFramePacer.getMissedDeadlineCount();
+        statistics.gpuScopes = mGPUProfiler.getScopeTimings();
+
+        return statistics;
+    }
 }
@@ -0,0 +1,114 @@
+/*
+BSD 2-Clause License
+Copyright (c) 2017, Davood Rasti and Alireza Rasti - rastisoft
+All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#pragma once
+
+#include <limits>
+#include <set>
+#include <unordered_map>
+#include <vector>
+#include "RS/Common/CommonTypes.h"
+
+namespace RS::Graphics::BaseGL
+{
+    /**
+        @description: Buddy allocator over the range [0, capacity). Blocks are minBlockSize << order
+        units large and are aligned to their size; freeing a block merges it with its buddy when the
+        buddy is free too. It only does the bookkeeping, the units can be bytes or elements.
+    */
+    class BuddyAllocator
+    {
+    protected:
+        ui32                                mMinBlockSize;
+        ui32                                mMaxOrder;
+        //Free block offsets per order, sorted so allocations prefer the low end of the range.
+        std::vector<std::set<ui32>>         mFreeBlocks;
+        //The order of every allocated block, keyed by its offset.
+        std::unordered_map<ui32, ui8>       mAllocatedBlocks;
+        ui32                                mAllocatedSize{0};
+
+        ui32                                getOrder(ui32 size) const noexcept;
+        void                                releaseBlock(ui32 offset, ui32 order);
+
+    public:
+        static constexpr ui32               InvalidOffset{std::numeric_limits<ui32>::max()};
+
+        /**
+            @description: BuddyAllocator constructor.
+            @param capacity: the size of the range, rounded up to minBlockSize times a power of two.
+            @param minBlockSize: the smallest block size.(a power of two)
+            @return
+        */
+                                            BuddyAllocator(ui32 capacity, ui32 minBlockSize);
+
+        /**
+            @description: Allocates a block of at least size units.
+            @param size: the requested size.
+            @return ui32: the block offset, or InvalidOffset if there is no free block large enough.
+        */
+        ui32                                allocate(ui32 size);
+        void                                free(ui32 offset);
+
+        /**
+            @description: Doubles the capacity, the new half becomes free.
+            @return void.
+        */
+        void                                grow(void);
+
+        ui32                                getCapacity(void) const noexcept;
+        ui32                                getMinBlockSize(void) const noexcept;
+        //The size of the allocated block at offset.
+        ui32                                getBlockSize(ui32 offset) const;
+        //The sum of the allocated block sizes, including the rounding to block sizes.
+        ui32                                getAllocatedSize(void) const noexcept;
+        ui32                                getFreeSize(void) const noexcept;
+        ui32                                getLargestFreeBlock(void) const noexcept;
+
+        /**
+            @description: Returns the external fragmentation: the part of the free space that is not
+            in the largest free block. 0 means all the free space can serve one allocation.
+            @return f32: in [0, 1].
+        */
+        f32                                 getFragmentation(void) const noexcept;
+    };
+
+    RS_INLINE ui32 BuddyAllocator::getCapacity(void) const noexcept
+    {
+        return mMinBlockSize << mMaxOrder;
+    }
+
+    RS_INLINE ui32 BuddyAllocator::getMinBlockSize(void) const noexcept
+    {
+        return mMinBlockSize;
+    }
+
+    RS_INLINE ui32 BuddyAllocator::getAllocatedSize(void) const noexcept
+    {
+        return mAllocatedSize;
+    }
+
+    RS_INLINE ui32 BuddyAllocator::getFreeSize(void) const noexcept
+    {
+        return getCapacity() - mAllocatedSize;
+    }
+}
\ No newline at end of file
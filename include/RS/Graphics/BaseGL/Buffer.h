@@ -24,57 +24,329 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #pragma once
 
 #include <GL/glew.h>
+#include <algorithm>
+#include <cassert>
+#include <utility>
 #include "RS/Common/CommonTypes.h"
+#include "RS/Graphics/BaseGL/DeletionQueue.h"
+#include "RS/Graphics/BaseGL/GLStateCache.h"
 
 namespace RS::Graphics::BaseGL
 {
+    //How often the content of a buffer is expected to change.
+    enum class BufferUsage
+    {
+        //Set once, drawn many times.
+        Static,
+        //Changed now and then, drawn many times.
+        Dynamic,
+        //Rewritten every frame.
+        Stream
+    };
+
     template <class T>
     class Buffer
     {
     private:
         GLuint      mBufferId;
         GLenum      mTarget;
+        BufferUsage mUsage;
+        //Bytes in use and bytes allocated.
+        ui32        mSize{0};
+        ui32        mCapacity{0};
+        //Changes whenever the buffer object is replaced.
+        ui32        mGeneration{0};
+
+        GLenum      getGLUsage(void) const noexcept;
+        //Binds the buffer to GL_COPY_WRITE_BUFFER for uploads. Binding mTarget instead would change
+        //the element array buffer of the bound vertex array for index buffers.
+        void        bindForUpload(void);
+
     public:
-                    Buffer(GLenum target);
+                    Buffer(GLenum target, BufferUsage usage = BufferUsage::Static);
+                    Buffer(const Buffer&) = delete;
+                    Buffer(Buffer&& other) noexcept;
+        Buffer&     operator=(const Buffer&) = delete;
+        Buffer&     operator=(Buffer&& other) noexcept;
         virtual     ~Buffer(void);
 
         void        bind(void);
         void        unbind(void);
 
+        /**
+            @description: Replaces the content of the buffer. The store is reallocated only if
+            size exceeds the capacity.
+            @param bufferData: the data, nullptr leaves the content undefined.
+            @param size: the size of the data in bytes.
+            @return void.
+        */
         void        set(const T* bufferData, ui32 size);
+
+        /**
+            @description: Updates a range of the buffer with glBufferSubData.
+            @param offset: the byte offset of the range.
+            @param bufferData: the data.
+            @param size: the size of the data in bytes. offset + size must not exceed the capacity.
+            @return void.
+        */
+        void        update(ui32 offset, const T* bufferData, ui32 size);
+
+        /**
+            @description: Detaches the store from the buffer and allocates a new one of the same
+            capacity, so the next writes do not wait for draws that still read the old data.
+            The content becomes undefined.
+            @return void.
+        */
+        void        orphan(void);
+
+        /**
+            @description: Per-frame upload path: orphans the store and writes size bytes at offset 0.
+            The capacity only grows, so the buffer name and the vertex arrays using it stay valid.
+            @param bufferData: the data.
+            @param size: the size of the data in bytes.
+            @return void.
+        */
+        void        stream(const T* bufferData, ui32 size);
+
+        /**
+            @description: Grows the capacity to at least capacity bytes, keeping the content. The
+            buffer object is replaced: getHandle() returns a new name, getGeneration() changes and
+            vertex arrays referencing the buffer must be set up again.
+            @param capacity: the minimum capacity in bytes.
+            @return void.
+        */
+        void        reserve(ui32 capacity);
+
+        /**
+            @description: Appends data after the used bytes, doubling the capacity when it is exceeded.
+            Growing goes through reserve(), so getHandle() and getGeneration() change and vertex arrays
+            referencing the buffer must be set up again.
+            @param bufferData: the data.
+            @param size: the size of the data in bytes.
+            @return ui32: the byte offset of the appended data.
+        */
+        ui32        append(const T* bufferData, ui32 size);
+
+        /**
+            @description: Copies a range of another buffer into this buffer on the GPU.
+            @param source: the source buffer.
+            @param sourceOffset: the byte offset of the range in source.
+            @param offset: the byte offset to copy to. offset + size must not exceed the capacity.
+            @param size: the size of the range in bytes.
+            @return void.
+        */
+        void        copyFrom(const Buffer<T>& source, ui32 sourceOffset, ui32 offset, ui32 size);
+
+        GLuint      getHandle(void) const noexcept;
+        GLenum      getTarget(void) const noexcept;
+        BufferUsage getUsage(void) const noexcept;
+        ui32        getSize(void) const noexcept;
+        ui32        getCapacity(void) const noexcept;
+        //Compare with a value saved at setup to find out whether the vertex arrays must be set up again.
+        ui32        getGeneration(void) const noexcept;
     };
 
     template <typename T>
-    Buffer<T>::Buffer(GLenum target): 
+    Buffer<T>::Buffer(GLenum target, BufferUsage usage): 
         mTarget(target)
         ,mBufferId(0)
+        ,mUsage(usage)
     {
         glGenBuffers(1, &mBufferId);
     }
 
+    template <typename T>
+    Buffer<T>::Buffer(Buffer&& other) noexcept :
+        mBufferId(std::exchange(other.mBufferId, 0))
+        ,mTarget(other.mTarget)
+        ,mUsage(other.mUsage)
+        ,mSize(std::exchange(other.mSize, 0))
+        ,mCapacity(std::exchange(other.mCapacity, 0))
+        ,mGeneration(other.mGeneration)
+    {
+    }
+
+    template <typename T>
+    Buffer<T>& Buffer<T>::operator=(Buffer&& other) noexcept
+    {
+        if(this != &other)
+        {
+            DeletionQueue::getCurrent().release(GLObjectType::Buffer, mBufferId);
+            mBufferId = std::exchange(other.mBufferId, 0);
+            mTarget = other.mTarget;
+            mUsage = other.mUsage;
+            mSize = std::exchange(other.mSize, 0);
+            mCapacity = std::exchange(other.mCapacity, 0);
+            ++mGeneration;
+        }
+
+        return *this;
+    }
+
     template <typename T>
     Buffer<T>::~Buffer(void)
     {
-        glDeleteBuffers(1, &mBufferId);
+        DeletionQueue::getCurrent().release(GLObjectType::Buffer, mBufferId);
         mBufferId = 0;
     }
 
+    template <typename T>
+    RS_INLINE GLenum Buffer<T>::getGLUsage(void) const noexcept
+    {
+        switch(mUsage)
+        {
+            case BufferUsage::Dynamic:
+                return GL_DYNAMIC_DRAW;
+            case BufferUsage::Stream:
+                return GL_STREAM_DRAW;
+            default:
+                return GL_STATIC_DRAW;
+        }
+    }
+
+    template <typename T>
+    RS_INLINE void Buffer<T>::bindForUpload(void)
+    {
+        GLStateCache::getCurrent().bindBuffer(GL_COPY_WRITE_BUFFER, mBufferId);
+    }
+
     template <typename T>
     RS_INLINE void Buffer<T>::bind(void)
     {
-        glBindBuffer(mTarget, mBufferId);
+        GLStateCache::getCurrent().bindBuffer(mTarget, mBufferId);
     }
 
     template <typename T>
     RS_INLINE void Buffer<T>::unbind(void)
     {
-        glBindBuffer(mTarget, 0);
+        GLStateCache::getCurrent().bindBuffer(mTarget, 0);
     }
 
     template <typename T>
     RS_INLINE void Buffer<T>::set(const T* bufferData, ui32 size)
     {
-        glBindBuffer(mTarget, mBufferId);
-        glBufferData(mTarget, size, bufferData, GL_STATIC_DRAW);
+        bindForUpload();
+        if(size > mCapacity)
+        {
+            glBufferData(GL_COPY_WRITE_BUFFER, size, bufferData, getGLUsage());
+            mCapacity = size;
+        }
+        else if(bufferData)
+            glBufferSubData(GL_COPY_WRITE_BUFFER, 0, size, bufferData);
+
+        mSize = size;
+    }
+
+    template <typename T>
+    RS_INLINE void Buffer<T>::update(ui32 offset, const T* bufferData, ui32 size)
+    {
+        assert(offset + size <= mCapacity);
+
+        bindForUpload();
+        glBufferSubData(GL_COPY_WRITE_BUFFER, offset, size, bufferData);
+        mSize = std::max(mSize, offset + size);
+    }
+
+    template <typename T>
+    RS_INLINE void Buffer<T>::orphan(void)
+    {
+        bindForUpload();
+        glBufferData(GL_COPY_WRITE_BUFFER, mCapacity, nullptr, getGLUsage());
+    }
+
+    template <typename T>
+    RS_INLINE void Buffer<T>::stream(const T* bufferData, ui32 size)
+    {
+        bindForUpload();
+        mCapacity = std::max(mCapacity, size);
+        glBufferData(GL_COPY_WRITE_BUFFER, mCapacity, nullptr, getGLUsage());
+        glBufferSubData(GL_COPY_WRITE_BUFFER, 0, size, bufferData);
+        mSize = size;
+    }
+
+    template <typename T>
+    void Buffer<T>::reserve(ui32 capacity)
+    {
+        if(capacity <= mCapacity)
+            return;
+
+        auto& stateCache = GLStateCache::getCurrent();
+
+        GLuint newBufferId;
+        glGenBuffers(1, &newBufferId);
+        stateCache.bindBuffer(GL_COPY_WRITE_BUFFER, newBufferId);
+        glBufferData(GL_COPY_WRITE_BUFFER, capacity, nullptr, getGLUsage());
+
+        if(mSize > 0)
+        {
+            stateCache.bindBuffer(GL_COPY_READ_BUFFER, mBufferId);
+            glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, mSize);
+        }
+
+        DeletionQueue::getCurrent().release(GLObjectType::Buffer, mBufferId);
+
+        mBufferId = newBufferId;
+        mCapacity = capacity;
+        ++mGeneration;
+    }
+
+    template <typename T>
+    ui32 Buffer<T>::append(const T* bufferData, ui32 size)
+    {
+        const ui32 offset = mSize;
+        if(offset + size > mCapacity)
+            reserve(std::max(mCapacity * 2, offset + size));
+
+        update(offset, bufferData, size);
+
+        return offset;
+    }
+
+    template <typename T>
+    RS_INLINE void Buffer<T>::copyFrom(const Buffer<T>& source, ui32 sourceOffset, ui32 offset, ui32 size)
+    {
+        assert(offset + size <= mCapacity && sourceOffset + size <= source.mCapacity);
+
+        auto& stateCache = GLStateCache::getCurrent();
+        stateCache.bindBuffer(GL_COPY_READ_BUFFER, source.mBufferId);
+        stateCache.bindBuffer(GL_COPY_WRITE_BUFFER, mBufferId);
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, sourceOffset, offset, size);
+        mSize = std::max(mSize, offset + size);
+    }
+
+    template <typename T>
+    RS_INLINE GLuint Buffer<T>::getHandle(void) const noexcept
+    {
+        return mBufferId;
+    }
+
+    template <typename T>
+    RS_INLINE GLenum Buffer<T>::getTarget(void) const noexcept
+    {
+        return mTarget;
+    }
+
+    template <typename T>
+    RS_INLINE BufferUsage Buffer<T>::getUsage(void) const noexcept
+    {
+        return mUsage;
+    }
+
+    template <typename T>
+    RS_INLINE ui32 Buffer<T>::getSize(void) const noexcept
+    {
+        return mSize;
+    }
+
+    template <typename T>
+    RS_INLINE ui32 Buffer<T>::getCapacity(void) const noexcept
+    {
+        return mCapacity;
+    }
+
+    template <typename T>
+    RS_INLINE ui32 Buffer<T>::getGeneration(void) const noexcept
+    {
+        return mGeneration;
     }
 };
\ No newline at end of file
@@ -0,0 +1,307 @@
+/*
+BSD 2-Clause License
+Copyright (c) 2017, Davood Rasti and Alireza Rasti - rastisoft
+All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#pragma once
+
+#include <GL/glew.h>
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <memory>
+#include <vector>
+#include "RS/Common/CommonTypes.h"
+#include "RS/Graphics/BaseGL/BaseGL.h"
+#include "RS/Graphics/BaseGL/Buffer.h"
+#include "RS/Graphics/BaseGL/BuddyAllocator.h"
+
+namespace RS::Graphics::BaseGL
+{
+    //Identifies an allocation in a BufferArena, it stays valid across growth and defragmentation.
+    typedef ui32 BufferArenaHandle;
+
+    /**
+        @description: Suballocates ranges of one large buffer, so many small meshes share a single
+        buffer object. Offsets are counted in elements of T: for a vertex arena getOffset() is the
+        base vertex, for an index arena it is the first index, so meshes sharing the arenas are drawn
+        with glDrawElementsBaseVertex and without rebinding.
+        The arena grows by doubling when it is full. Growth and defragment() replace the buffer
+        object, getGeneration() changes then and the vertex arrays using the arena must be set up again.
+    */
+    template <class T>
+    class BufferArena
+    {
+    private:
+        struct Allocation
+        {
+            ui32                            offset;
+            ui32                            count;
+        };
+
+        BufferUPT<T>                        mBuffer;
+        BuddyAllocator                      mAllocator;
+        std::vector<Allocation>             mAllocations;
+        std::vector<BufferArenaHandle>      mFreeHandles;
+        ui32                                mInitialCapacity;
+        ui32                                mGeneration{0};
+
+        bool                                isLive(BufferArenaHandle handle) const noexcept;
+
+    public:
+        static constexpr BufferArenaHandle  InvalidHandle{std::numeric_limits<ui32>::max()};
+
+        /**
+            @description: BufferArena constructor.
+            @param target: the buffer target.(GL_ARRAY_BUFFER or GL_ELEMENT_ARRAY_BUFFER)
+            @param capacity: the initial capacity in elements.
+            @param minBlockSize: the smallest allocation in elements.(a power of two)
+            @param usage: the usage hint of the buffer.
+            @return
+        */
+                                            BufferArena(GLenum target, ui32 capacity, ui32 minBlockSize = 64,
+                                                        BufferUsage usage = BufferUsage::Static);
+                                            BufferArena(const BufferArena&) = delete;
+                                            BufferArena(BufferArena&&) = default;
+        BufferArena&                        operator=(const BufferArena&) = delete;
+        BufferArena&                        operator=(BufferArena&&) = default;
+
+        /**
+            @description: Allocates count elements and uploads data to them, growing the arena if needed.
+            @param data: the elements, nullptr leaves them undefined.
+            @param count: the number of elements.
+            @return BufferArenaHandle.
+        */
+        BufferArenaHandle                   allocate(const T* data, ui32 count);
+        void                                free(BufferArenaHandle handle);
+
+        /**
+            @description: Updates elements of an allocation.
+            @param handle: the allocation.
+            @param data: the elements.
+            @param count: the number of elements.
+            @param elementOffset: the first element to update, relative to the allocation.
+            @return void.
+        */
+        void                                update(BufferArenaHandle handle, const T* data, ui32 count, ui32 elementOffset = 0);
+
+        /**
+            @description: Moves the live allocations into a new, tightly packed buffer on the GPU,
+            largest first, and shrinks the arena down to what they need (but not below the initial
+            capacity). Handles stay valid, their offsets change.
+            @return void.
+        */
+        void                                defragment(void);
+
+        //The offset in elements. (base vertex/first index)
+        ui32                                getOffset(BufferArenaHandle handle) const noexcept;
+        //The offset in bytes. (the indices argument of glDrawElements*)
+        GLintptr                            getByteOffset(BufferArenaHandle handle) const noexcept;
+        ui32                                getCount(BufferArenaHandle handle) const noexcept;
+
+        Buffer<T>&                          getBuffer(void) noexcept;
+        GLuint                              getHandle(void) const noexcept;
+        ui32                                getGeneration(void) const noexcept;
+        ui32                                getAllocationCount(void) const noexcept;
+        //The capacity in elements.
+        ui32                                getCapacity(void) const noexcept;
+        //The number of elements in use, without the rounding to block sizes.
+        ui32                                getUsedSize(void) const noexcept;
+        //See BuddyAllocator::getFragmentation().
+        f32                                 getFragmentation(void) const noexcept;
+    };
+
+    template <class T>
+    BufferArena<T>::BufferArena(GLenum target, ui32 capacity, ui32 minBlockSize, BufferUsage usage) :
+        mBuffer(std::make_unique<Buffer<T>>(target, usage)),
+        mAllocator(capacity, minBlockSize),
+        mInitialCapacity(mAllocator.getCapacity())
+    {
+        mBuffer->reserve(mAllocator.getCapacity() * sizeof(T));
+    }
+
+    template <class T>
+    RS_INLINE bool BufferArena<T>::isLive(BufferArenaHandle handle) const noexcept
+    {
+        return handle < mAllocations.size() && mAllocations[handle].count > 0;
+    }
+
+    template <class T>
+    BufferArenaHandle BufferArena<T>::allocate(const T* data, ui32 count)
+    {
+        assert(count > 0);
+
+        ui32 offset = mAllocator.allocate(count);
+        while(offset == BuddyAllocator::InvalidOffset)
+        {
+            mAllocator.grow();
+            offset = mAllocator.allocate(count);
+        }
+
+        if(mAllocator.getCapacity() * sizeof(T) > mBuffer->getCapacity())
+        {
+            mBuffer->reserve(mAllocator.getCapacity() * sizeof(T));
+            ++mGeneration;
+        }
+
+        //Written through GL_COPY_WRITE_BUFFER, an index arena does not rebind the index buffer of the bound vertex array.
+        if(data)
+            mBuffer->update(offset * sizeof(T), data, count * sizeof(T));
+
+        BufferArenaHandle handle;
+        if(mFreeHandles.empty())
+        {
+            handle = static_cast<BufferArenaHandle>(mAllocations.size());
+            mAllocations.push_back({offset, count});
+        }
+        else
+        {
+            handle = mFreeHandles.back();
+            mFreeHandles.pop_back();
+            mAllocations[handle] = {offset, count};
+        }
+
+        return handle;
+    }
+
+    template <class T>
+    void BufferArena<T>::free(BufferArenaHandle handle)
+    {
+        assert(isLive(handle));
+
+        mAllocator.free(mAllocations[handle].offset);
+        mAllocations[handle] = {0, 0};
+        mFreeHandles.push_back(handle);
+    }
+
+    template <class T>
+    RS_INLINE void BufferArena<T>::update(BufferArenaHandle handle, const T* data, ui32 count, ui32 elementOffset)
+    {
+        assert(isLive(handle) && elementOffset + count <= mAllocations[handle].count);
+
+        mBuffer->update((mAllocations[handle].offset + elementOffset) * sizeof(T), data, count * sizeof(T));
+    }
+
+    template <class T>
+    void BufferArena<T>::defragment(void)
+    {
+        std::vector<BufferArenaHandle> liveHandles;
+        ui32 neededSize{0};
+        for(BufferArenaHandle handle = 0; handle < mAllocations.size(); ++handle)
+        {
+            if(isLive(handle))
+            {
+                liveHandles.push_back(handle);
+                neededSize += mAllocator.getBlockSize(mAllocations[handle].offset);
+            }
+        }
+
+        //Placing the blocks largest first leaves no holes between them.
+        std::sort(liveHandles.begin(), liveHandles.end(), [this](BufferArenaHandle a, BufferArenaHandle b)
+        {
+            const ui32 sizeA = mAllocator.getBlockSize(mAllocations[a].offset);
+            const ui32 sizeB = mAllocator.getBlockSize(mAllocations[b].offset);
+            return sizeA != sizeB ? sizeA > sizeB : mAllocations[a].offset < mAllocations[b].offset;
+        });
+
+        BuddyAllocator packedAllocator(std::max(neededSize, mInitialCapacity), mAllocator.getMinBlockSize());
+        auto packedBuffer = std::make_unique<Buffer<T>>(mBuffer->getTarget(), mBuffer->getUsage());
+        packedBuffer->reserve(packedAllocator.getCapacity() * sizeof(T));
+
+        for(const auto handle : liveHandles)
+        {
+            auto& allocation = mAllocations[handle];
+            const ui32 offset = packedAllocator.allocate(allocation.count);
+            assert(offset != BuddyAllocator::InvalidOffset);
+
+            packedBuffer->copyFrom(*mBuffer, allocation.offset * sizeof(T), offset * sizeof(T), allocation.count * sizeof(T));
+            allocation.offset = offset;
+        }
+
+        mAllocator = std::move(packedAllocator);
+        mBuffer = std::move(packedBuffer);
+        ++mGeneration;
+    }
+
+    template <class T>
+    RS_INLINE ui32 BufferArena<T>::getOffset(BufferArenaHandle handle) const noexcept
+    {
+        return mAllocations[handle].offset;
+    }
+
+    template <class T>
+    RS_INLINE GLintptr BufferArena<T>::getByteOffset(BufferArenaHandle handle) const noexcept
+    {
+        return static_cast<GLintptr>(mAllocations[handle].offset) * sizeof(T);
+    }
+
+    template <class T>
+    RS_INLINE ui32 BufferArena<T>::getCount(BufferArenaHandle handle) const noexcept
+    {
+        return mAllocations[handle].count;
+    }
+
+    template <class T>
+    RS_INLINE Buffer<T>& BufferArena<T>::getBuffer(void) noexcept
+    {
+        return *mBuffer;
+    }
+
+    template <class T>
+    RS_INLINE GLuint BufferArena<T>::getHandle(void) const noexcept
+    {
+        return mBuffer->getHandle();
+    }
+
+    template <class T>
+    RS_INLINE ui32 BufferArena<T>::getGeneration(void) const noexcept
+    {
+        return mGeneration;
+    }
+
+    template <class T>
+    RS_INLINE ui32 BufferArena<T>::getAllocationCount(void) const noexcept
+    {
+        return static_cast<ui32>(mAllocations.size() - mFreeHandles.size());
+    }
+
+    template <class T>
+    RS_INLINE ui32 BufferArena<T>::getCapacity(void) const noexcept
+    {
+        return mAllocator.getCapacity();
+    }
+
+    template <class T>
+    ui32 BufferArena<T>::getUsedSize(void) const noexcept
+    {
+        ui32 usedSize{0};
+        for(const auto& allocation : mAllocations)
+            usedSize += allocation.count;
+
+        return usedSize;
+    }
+
+    template <class T>
+    RS_INLINE f32 BufferArena<T>::getFragmentation(void) const noexcept
+    {
+        return mAllocator.getFragmentation();
+    }
+}
\ No newline at end of file
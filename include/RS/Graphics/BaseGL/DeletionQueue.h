@@ -0,0 +1,127 @@
+/*
+BSD 2-Clause License
+Copyright (c) 2017, Davood Rasti and Alireza Rasti - rastisoft
+All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#pragma once
+
+#include <GL/glew.h>
+#include <deque>
+#include <mutex>
+#include <vector>
+#include "RS/Common/CommonTypes.h"
+
+namespace RS::Graphics::BaseGL
+{
+    enum class GLObjectType : ui8
+    {
+        Buffer,
+        Texture,
+        Program,
+        Shader,
+        VertexArray,
+        FrameBuffer,
+        RenderBuffer
+    };
+
+    /**
+        @description: Defers the deletion of GL objects until the GPU has finished the frames that may
+        still use them: the objects released during a frame are deleted once the fence placed at the
+        end of that frame has signalled, so releasing a resource mid-frame never waits for the GPU.
+        Every thread has a current queue, like GLStateCache. BaseGLApp makes its own queue current on
+        the threads it runs, without a current queue the default one of the thread deletes at once.
+        release() may be called from any thread, the deletions happen in endFrame() on the thread
+        that owns the context.
+    */
+    class DeletionQueue
+    {
+    protected:
+        struct PendingDeletion
+        {
+            GLObjectType                    type;
+            GLuint                          name;
+        };
+
+        struct PendingFrame
+        {
+            GLsync                          fence;
+            std::vector<PendingDeletion>    deletions;
+        };
+
+        static thread_local DeletionQueue*  mCurrentDeletionQueue;
+
+        std::mutex                          mMutex;
+        std::vector<PendingDeletion>        mFrameDeletions;
+        std::deque<PendingFrame>            mPendingFrames;
+        ui64                                mDeletedObjectCount{0};
+        bool                                mIsDeferred;
+
+        void                                deleteObject(const PendingDeletion& deletion);
+
+    public:
+        /**
+            @description: DeletionQueue constructor.
+            @param isDeferred: a queue that is not deferred deletes the objects at once.
+            @return
+        */
+                                            DeletionQueue(bool isDeferred = true);
+                                            DeletionQueue(const DeletionQueue&) = delete;
+        DeletionQueue&                      operator=(const DeletionQueue&) = delete;
+        virtual                             ~DeletionQueue(void);
+
+        static DeletionQueue&               getCurrent(void);
+        static void                         setCurrent(DeletionQueue* deletionQueue);
+
+        /**
+            @description: Hands a GL object over to the queue. Name 0 is ignored.
+            @param type: the object type.
+            @param name: the object name.
+            @return void.
+        */
+        void                                release(GLObjectType type, GLuint name);
+
+        /**
+            @description: Fences the objects released in this frame and deletes the ones whose fence
+            has signalled. It must be called once per frame after the last draw call.
+            @return void.
+        */
+        void                                endFrame(void);
+
+        /**
+            @description: Waits for all the fences and deletes every pending object. (e.g. at shutdown)
+            @return void.
+        */
+        void                                flush(void);
+
+        ui32                                getPendingFrameCount(void) const noexcept;
+        ui64                                getDeletedObjectCount(void) const noexcept;
+    };
+
+    RS_INLINE ui32 DeletionQueue::getPendingFrameCount(void) const noexcept
+    {
+        return static_cast<ui32>(mPendingFrames.size());
+    }
+
+    RS_INLINE ui64 DeletionQueue::getDeletedObjectCount(void) const noexcept
+    {
+        return mDeletedObjectCount;
+    }
+}
\ No newline at end of file
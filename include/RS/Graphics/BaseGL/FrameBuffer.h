@@ -0,0 +1,89 @@
+/*
+BSD 2-Clause License
+Copyright (c) 2017, Davood Rasti and Alireza Rasti - rastisoft
+All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#pragma once
+
+#include <GL/glew.h>
+#include "RS/Common/CommonTypes.h"
+
+namespace RS::Graphics::BaseGL
+{
+    class FrameBuffer
+    {
+    protected:
+        GLuint      mFrameBufferHandle{0};
+        GLuint      mColorRenderBufferHandle{0};
+        GLuint      mDepthRenderBufferHandle{0};
+        i32         mWidth;
+        i32         mHeight;
+
+        void        release(void);
+
+    public:
+        /**
+            @description: Creates a framebuffer with an RGBA8 color and a depth/stencil
+            renderbuffer attachment of the given size.
+            @param width: the framebuffer width.
+            @param height: the framebuffer height.
+            @return
+        */
+                    FrameBuffer(i32 width, i32 height);
+                    FrameBuffer(const FrameBuffer&) = delete;
+                    FrameBuffer(FrameBuffer&& other) noexcept;
+        FrameBuffer& operator=(const FrameBuffer&) = delete;
+        FrameBuffer& operator=(FrameBuffer&& other) noexcept;
+        virtual     ~FrameBuffer(void);
+
+        void        bind(void);
+        void        unbind(void);
+
+        i32         getWidth(void);
+        i32         getHeight(void);
+        GLuint      getHandle(void);
+    };
+
+    RS_INLINE void FrameBuffer::bind(void)
+    {
+        glBindFramebuffer(GL_FRAMEBUFFER, mFrameBufferHandle);
+    }
+
+    RS_INLINE void FrameBuffer::unbind(void)
+    {
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    }
+
+    RS_INLINE i32 FrameBuffer::getWidth(void)
+    {
+        return mWidth;
+    }
+
+    RS_INLINE i32 FrameBuffer::getHeight(void)
+    {
+        return mHeight;
+    }
+
+    RS_INLINE GLuint FrameBuffer::getHandle(void)
+    {
+        return mFrameBufferHandle;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,97 @@
+/*
+BSD 2-Clause License
+Copyright (c) 2017, Davood Rasti and Alireza Rasti - rastisoft
+All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include "RS/Common/CommonTypes.h"
+
+namespace RS::Graphics::BaseGL
+{
+    /**
+        @description: Paces frames to a target interval. It sleeps until shortly before the
+        deadline and spins for the rest, the spin window adapts to the observed sleep overshoot.
+        Deadlines advance by exactly one interval so the error of a frame is corrected in the
+        next one; when a frame misses the next deadline entirely the schedule restarts from now
+        instead of rendering a burst of catch-up frames.
+    */
+    class FramePacer
+    {
+    protected:
+        using Clock = std::chrono::steady_clock;
+
+        Clock::time_point           mNextDeadline;
+        Clock::duration             mTargetInterval{0};
+        //Time before the deadline that is spent spinning instead of sleeping.(in millisec)
+        double                      mSpinThreshold{2.0};
+        f32                         mLastJitter{0.0f};
+        //Read by getFrameStatistics() from any thread.
+        std::atomic<ui64>           mMissedDeadlineCount{0};
+
+    public:
+        /**
+            @description: Sets the target frame interval. 0 disables pacing.
+            @param interval: the frame interval.(in millisec)
+            @return void.
+        */
+        void                        setTargetInterval(double interval);
+        double                      getTargetInterval(void) const noexcept;
+
+        /**
+            @description: Restarts the schedule, the next deadline is one interval from now.
+            @return void.
+        */
+        void                        reset(void);
+
+        /**
+            @description: Waits until the current deadline and schedules the next one.
+            @return f32: the jitter, i.e. how late the wait returned after the deadline.(in millisec)
+            If the deadline had already passed it is the overrun, i.e. how late the frame reached the pacer.
+        */
+        f32                         wait(void);
+
+        f32                         getLastJitter(void) const noexcept;
+
+        /**
+            @description: Returns the number of frames that reached the pacer after their deadline.
+            @return ui64.
+        */
+        ui64                        getMissedDeadlineCount(void) const noexcept;
+    };
+
+    RS_INLINE double FramePacer::getTargetInterval(void) const noexcept
+    {
+        return std::chrono::duration<double, std::milli>(mTargetInterval).count();
+    }
+
+    RS_INLINE f32 FramePacer::getLastJitter(void) const noexcept
+    {
+        return mLastJitter;
+    }
+
+    RS_INLINE ui64 FramePacer::getMissedDeadlineCount(void) const noexcept
+    {
+        return mMissedDeadlineCount;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,149 @@
+/*
+BSD 2-Clause License
+Copyright (c) 2017, Davood Rasti and Alireza Rasti - rastisoft
+All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <string>
+#include <vector>
+#include "RS/Common/CommonTypes.h"
+
+namespace RS::Graphics::BaseGL
+{
+    //Timings of the phases of a single frame.(in millisec)
+    struct FrameSample
+    {
+        f32         pollTime{0.0f};
+        f32         updateTime{0.0f};
+        f32         renderTime{0.0f};
+        f32         limiterTime{0.0f};
+        f32         swapTime{0.0f};
+        //Work done after the swap.(deferred deletions, readback polling, shader reloads, ...)
+        f32         housekeepingTime{0.0f};
+        f32         frameTime{0.0f};
+        //How late the frame pacer returned after its deadline, the overrun if the deadline was missed.
+        f32         pacerJitter{0.0f};
+    };
+
+    struct TimingSummary
+    {
+        f32         min{0.0f};
+        f32         avg{0.0f};
+        f32         p50{0.0f};
+        f32         p95{0.0f};
+        f32         p99{0.0f};
+        f32         max{0.0f};
+    };
+
+    //Timing of a named profiler scope.(in millisec)
+    struct ScopeTiming
+    {
+        std::string     name;
+        f32             lastTime{0.0f};
+        f32             avgTime{0.0f};
+        f32             maxTime{0.0f};
+        ui64            sampleCount{0};
+    };
+
+    struct FrameStatistics
+    {
+        ui32            frameCount{0};
+        TimingSummary   pollTime;
+        TimingSummary   updateTime;
+        TimingSummary   renderTime;
+        TimingSummary   limiterTime;
+        TimingSummary   swapTime;
+        TimingSummary   housekeepingTime;
+        TimingSummary   frameTime;
+        TimingSummary   pacerJitter;
+        //Frames that reached the frame pacer after their deadline since it was created.(see FramePacer)
+        ui64            missedDeadlineCount{0};
+        //GPU time of the profiled scopes, see GPUProfiler.
+        std::vector<ScopeTiming> gpuScopes;
+    };
+
+    /**
+        @description: Fixed size ring buffer of the latest frame samples. One thread
+        records samples while any thread may read them without locking; samples that
+        are overwritten while being read are dropped from the result.
+    */
+    class FrameTimeRecorder
+    {
+    public:
+        static constexpr ui32       capacity{1024};
+
+    protected:
+        std::array<FrameSample, capacity>   mSamples;
+        std::atomic<ui64>                   mWriteIndex{0};
+
+    public:
+        /**
+            @description: Stores a sample, overwriting the oldest one when the buffer is full.
+            It must be called from one thread only.
+            @param sample: the frame sample.
+            @return void.
+        */
+        void                        record(const FrameSample& sample) noexcept;
+
+        /**
+            @description: Copies the latest samples, oldest first.
+            @param outSamples: destination array with room for sampleCount samples.
+            @param sampleCount: the number of samples requested.
+            @return ui32: the number of samples copied.
+        */
+        ui32                        copyLatest(FrameSample* outSamples, ui32 sampleCount) const noexcept;
+
+        /**
+            @description: Computes min/avg/p50/p95/p99/max of every phase over the latest frames.
+            @param frameCount: the number of latest frames to consider.(at most capacity)
+            @return FrameStatistics.
+        */
+        FrameStatistics             getStatistics(ui32 frameCount = capacity) const;
+
+        /**
+            @description: Returns the number of samples recorded since creation.
+            @return ui64.
+        */
+        ui64                        getRecordedCount(void) const noexcept;
+
+        void                        clear(void) noexcept;
+    };
+
+    RS_INLINE void FrameTimeRecorder::record(const FrameSample& sample) noexcept
+    {
+        const ui64 index = mWriteIndex.load(std::memory_order_relaxed);
+        mSamples[index % capacity] = sample;
+        mWriteIndex.store(index + 1, std::memory_order_release);
+    }
+
+    RS_INLINE ui64 FrameTimeRecorder::getRecordedCount(void) const noexcept
+    {
+        return mWriteIndex.load(std::memory_order_acquire);
+    }
+
+    RS_INLINE void FrameTimeRecorder::clear(void) noexcept
+    {
+        mWriteIndex.store(0, std::memory_order_release);
+    }
+}
\ No newline at end of file
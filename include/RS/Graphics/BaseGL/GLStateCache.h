@@ -0,0 +1,262 @@
+/*
+BSD 2-Clause License
+Copyright (c) 2017, Davood Rasti and Alireza Rasti - rastisoft
+All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#pragma once
+
+#include <GL/glew.h>
+#include <array>
+#include "RS/Common/CommonTypes.h"
+
+namespace RS::Graphics::BaseGL
+{
+    /**
+        @description: Tracks the GL bindings of a context (program, vertex array, buffer per target,
+        2D texture per unit and the active texture unit) and skips binds that would not change
+        anything. Every thread has a current cache, BaseGLApp makes its own cache current on the
+        thread that owns the context. Without a current cache the default one of the thread issues
+        every call. GL calls that bypass the cache must be followed by invalidate().
+    */
+    class GLStateCache
+    {
+    public:
+        static constexpr ui32       maxTextureUnits{32};
+
+    protected:
+        static constexpr GLuint     unknownBinding{~0u};
+
+        enum BufferTarget : ui8
+        {
+            ArrayBuffer = 0,
+            ElementArrayBuffer,
+            UniformBuffer,
+            PixelPackBuffer,
+            PixelUnpackBuffer,
+            CopyReadBuffer,
+            CopyWriteBuffer,
+            DrawIndirectBuffer,
+            TextureBuffer,
+            TransformFeedbackBuffer,
+            BufferTargetCount,
+            UntrackedBuffer = BufferTargetCount
+        };
+
+        static thread_local GLStateCache*   mCurrentStateCache;
+
+        std::array<GLuint, BufferTargetCount>   mBuffers;
+        std::array<GLuint, maxTextureUnits>     mTextures;
+        GLuint                      mProgram;
+        GLuint                      mVertexArray;
+        ui32                        mActiveTextureUnit;
+        ui64                        mIssuedCallCount{0};
+        ui64                        mElidedCallCount{0};
+        bool                        mIsEnabled;
+
+        static BufferTarget         getBufferTarget(GLenum target) noexcept;
+
+    public:
+        /**
+            @description: GLStateCache constructor.
+            @param isEnabled: a disabled cache issues every call but still counts them.
+            @return
+        */
+                                    GLStateCache(bool isEnabled = true);
+                                    GLStateCache(const GLStateCache&) = delete;
+        GLStateCache&               operator=(const GLStateCache&) = delete;
+
+        /**
+            @description: Returns the current cache of the calling thread.
+            @return GLStateCache&.
+        */
+        static GLStateCache&        getCurrent(void);
+
+        /**
+            @description: Makes a cache current on the calling thread. nullptr restores the default one.
+            @param stateCache: the cache of the context that is current on this thread.
+            @return void.
+        */
+        static void                 setCurrent(GLStateCache* stateCache);
+
+        /**
+            @description: Forgets all tracked bindings, the next bind of each kind is issued.
+            @return void.
+        */
+        void                        invalidate(void);
+
+        void                        useProgram(GLuint program);
+        void                        bindVertexArray(GLuint vertexArray);
+        void                        bindBuffer(GLenum target, GLuint buffer);
+        void                        activeTexture(ui32 textureUnit);
+        //Binds to the active texture unit.
+        void                        bindTexture(GLenum target, GLuint texture);
+        //Makes textureUnit active and binds to it.
+        void                        bindTexture(ui32 textureUnit, GLenum target, GLuint texture);
+
+        /**
+            @description: Must be called when an object is deleted, GL unbinds deleted objects.
+            @return void.
+        */
+        void                        onProgramDeleted(GLuint program);
+        void                        onVertexArrayDeleted(GLuint vertexArray);
+        void                        onBufferDeleted(GLuint buffer);
+        void                        onTextureDeleted(GLuint texture);
+
+        /**
+            @description: Must be called after a buffer is bound to a target by other means.(e.g. glBindBufferBase)
+            @return void.
+        */
+        void                        onBufferBound(GLenum target, GLuint buffer);
+
+        ui64                        getIssuedCallCount(void) const noexcept;
+        ui64                        getElidedCallCount(void) const noexcept;
+        void                        resetCounters(void) noexcept;
+    };
+
+    RS_INLINE GLStateCache::BufferTarget GLStateCache::getBufferTarget(GLenum target) noexcept
+    {
+        switch(target)
+        {
+            case GL_ARRAY_BUFFER:
+                return ArrayBuffer;
+            case GL_ELEMENT_ARRAY_BUFFER:
+                return ElementArrayBuffer;
+            case GL_UNIFORM_BUFFER:
+                return UniformBuffer;
+            case GL_PIXEL_PACK_BUFFER:
+                return PixelPackBuffer;
+            case GL_PIXEL_UNPACK_BUFFER:
+                return PixelUnpackBuffer;
+            case GL_COPY_READ_BUFFER:
+                return CopyReadBuffer;
+            case GL_COPY_WRITE_BUFFER:
+                return CopyWriteBuffer;
+            case GL_DRAW_INDIRECT_BUFFER:
+                return DrawIndirectBuffer;
+            case GL_TEXTURE_BUFFER:
+                return TextureBuffer;
+            case GL_TRANSFORM_FEEDBACK_BUFFER:
+                return TransformFeedbackBuffer;
+            default:
+                return UntrackedBuffer;
+        }
+    }
+
+    RS_INLINE void GLStateCache::useProgram(GLuint program)
+    {
+        if(mIsEnabled && mProgram == program)
+        {
+            ++mElidedCallCount;
+            return;
+        }
+
+        mProgram = program;
+        ++mIssuedCallCount;
+        glUseProgram(program);
+    }
+
+    RS_INLINE void GLStateCache::bindVertexArray(GLuint vertexArray)
+    {
+        if(mIsEnabled && mVertexArray == vertexArray)
+        {
+            ++mElidedCallCount;
+            return;
+        }
+
+        //The element array buffer binding is part of the vertex array state.
+        mVertexArray = vertexArray;
+        mBuffers[ElementArrayBuffer] = unknownBinding;
+        ++mIssuedCallCount;
+        glBindVertexArray(vertexArray);
+    }
+
+    RS_INLINE void GLStateCache::bindBuffer(GLenum target, GLuint buffer)
+    {
+        const auto bufferTarget = getBufferTarget(target);
+        if(mIsEnabled && bufferTarget != UntrackedBuffer && mBuffers[bufferTarget] == buffer)
+        {
+            ++mElidedCallCount;
+            return;
+        }
+
+        if(bufferTarget != UntrackedBuffer)
+            mBuffers[bufferTarget] = buffer;
+        ++mIssuedCallCount;
+        glBindBuffer(target, buffer);
+    }
+
+    RS_INLINE void GLStateCache::activeTexture(ui32 textureUnit)
+    {
+        if(mIsEnabled && mActiveTextureUnit == textureUnit)
+        {
+            ++mElidedCallCount;
+            return;
+        }
+
+        mActiveTextureUnit = textureUnit;
+        ++mIssuedCallCount;
+        glActiveTexture(GL_TEXTURE0 + textureUnit);
+    }
+
+    RS_INLINE void GLStateCache::bindTexture(GLenum target, GLuint texture)
+    {
+        const bool isTracked = (target == GL_TEXTURE_2D && mActiveTextureUnit < maxTextureUnits);
+        if(mIsEnabled && isTracked && mTextures[mActiveTextureUnit] == texture)
+        {
+            ++mElidedCallCount;
+            return;
+        }
+
+        if(isTracked)
+            mTextures[mActiveTextureUnit] = texture;
+        ++mIssuedCallCount;
+        glBindTexture(target, texture);
+    }
+
+    RS_INLINE void GLStateCache::bindTexture(ui32 textureUnit, GLenum target, GLuint texture)
+    {
+        //The unit is made active even if the texture is already bound, callers rely on it.(e.g. glTexParameter*)
+        activeTexture(textureUnit);
+        bindTexture(target, texture);
+    }
+
+    RS_INLINE void GLStateCache::onBufferBound(GLenum target, GLuint buffer)
+    {
+        if(const auto bufferTarget = getBufferTarget(target); bufferTarget != UntrackedBuffer)
+            mBuffers[bufferTarget] = buffer;
+    }
+
+    RS_INLINE ui64 GLStateCache::getIssuedCallCount(void) const noexcept
+    {
+        return mIssuedCallCount;
+    }
+
+    RS_INLINE ui64 GLStateCache::getElidedCallCount(void) const noexcept
+    {
+        return mElidedCallCount;
+    }
+
+    RS_INLINE void GLStateCache::resetCounters(void) noexcept
+    {
+        mIssuedCallCount = 0;
+        mElidedCallCount = 0;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,179 @@
+/*
+BSD 2-Clause License
+Copyright (c) 2017, Davood Rasti and Alireza Rasti - rastisoft
+All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#pragma once
+
+#include <GL/glew.h>
+#include <array>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "RS/Common/CommonTypes.h"
+#include "RS/Graphics/BaseGL/FrameTimeRecorder.h"
+
+namespace RS::Graphics::BaseGL
+{
+    /**
+        @description: Measures GPU time of named scopes with GL_TIMESTAMP queries. Every frame
+        uses its own pool of query objects and the results of a frame are read back
+        frameLatency frames later, only if they are already available, so collecting
+        them never stalls the pipeline. Timestamps (rather than GL_TIME_ELAPSED) allow
+        scopes to be nested.
+    */
+    class GPUProfiler
+    {
+    public:
+        static constexpr ui32       frameLatency{4};
+
+    protected:
+        struct ScopeQuery
+        {
+            ui32                    scopeId;
+            ui32                    beginQueryIndex;
+            ui32                    endQueryIndex;
+        };
+
+        struct FrameQueries
+        {
+            std::vector<GLuint>     queries;
+            std::vector<ScopeQuery> scopes;
+            ui32                    usedQueryCount{0};
+            bool                    isPending{false};
+        };
+
+        std::array<FrameQueries, frameLatency>      mFrames;
+        std::unordered_map<std::string, ui32>       mScopeIds;
+        std::vector<ScopeTiming>                    mScopeTimings;
+        std::vector<ui32>                           mOpenScopes;
+        mutable std::mutex                          mScopeTimingsMutex;
+        ui64                                        mFrameIndex{0};
+        ui64                                        mDroppedFrameCount{0};
+        bool                                        mIsEnabled{false};
+        bool                                        mIsInFrame{false};
+
+        ui32                        getQuery(FrameQueries& frame);
+        void                        collect(FrameQueries& frame);
+
+    public:
+                                    GPUProfiler(void) = default;
+                                    GPUProfiler(const GPUProfiler&) = delete;
+        GPUProfiler&                operator=(const GPUProfiler&) = delete;
+        virtual                     ~GPUProfiler(void);
+
+        /**
+            @description: Enables/disables the profiler. A disabled profiler issues no GL calls.
+            @param isEnabled: the new state.
+            @return void.
+        */
+        void                        setEnabled(bool isEnabled);
+        bool                        isEnabled(void) const noexcept;
+
+        /**
+            @description: Returns the id of a scope name, registering it if needed. Using the id
+            with beginScope() avoids the name lookup per frame.
+            @param name: the scope name.
+            @return ui32.
+        */
+        ui32                        getScopeId(const std::string& name);
+
+        /**
+            @description: Starts a new frame and reads back the results of the frame that
+            was recorded frameLatency frames ago into the same query pool.
+            @return void.
+        */
+        void                        beginFrame(void);
+        void                        endFrame(void);
+
+        void                        beginScope(ui32 scopeId);
+        void                        beginScope(const std::string& name);
+        void                        endScope(void);
+
+        /**
+            @description: Returns a copy of the timings of all scopes. It can be called from any thread.
+            @return std::vector<ScopeTiming>.
+        */
+        std::vector<ScopeTiming>    getScopeTimings(void) const;
+
+        /**
+            @description: Returns the number of frames whose results were not available when
+            their query pool was reused.(They are skipped instead of waiting for the GPU)
+            @return ui64.
+        */
+        ui64                        getDroppedFrameCount(void) const noexcept;
+
+        /**
+            @description: Deletes the query objects and drops the pending results. It must be
+            called while the GL context is still current.
+            @return void.
+        */
+        void                        releaseQueries(void);
+    };
+
+    //Profiles the GPU time between its construction and destruction.
+    class GPUProfileScope
+    {
+    protected:
+        GPUProfiler&                mProfiler;
+
+    public:
+                                    GPUProfileScope(GPUProfiler& profiler, ui32 scopeId);
+                                    GPUProfileScope(GPUProfiler& profiler, const std::string& name);
+                                    GPUProfileScope(const GPUProfileScope&) = delete;
+        GPUProfileScope&            operator=(const GPUProfileScope&) = delete;
+                                    ~GPUProfileScope(void);
+    };
+
+    RS_INLINE bool GPUProfiler::isEnabled(void) const noexcept
+    {
+        return mIsEnabled;
+    }
+
+    RS_INLINE void GPUProfiler::beginScope(const std::string& name)
+    {
+        if(mIsEnabled)
+            beginScope(getScopeId(name));
+    }
+
+    RS_INLINE ui64 GPUProfiler::getDroppedFrameCount(void) const noexcept
+    {
+        return mDroppedFrameCount;
+    }
+
+    RS_INLINE GPUProfileScope::GPUProfileScope(GPUProfiler& profiler, ui32 scopeId) :
+        mProfiler(profiler)
+    {
+        mProfiler.beginScope(scopeId);
+    }
+
+    RS_INLINE GPUProfileScope::GPUProfileScope(GPUProfiler& profiler, const std::string& name) :
+        mProfiler(profiler)
+    {
+        mProfiler.beginScope(name);
+    }
+
+    RS_INLINE GPUProfileScope::~GPUProfileScope(void)
+    {
+        mProfiler.endScope();
+    }
+}
\ No newline at end of file
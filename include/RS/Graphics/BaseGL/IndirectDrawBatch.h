@@ -0,0 +1,225 @@
+/*
+BSD 2-Clause License
+Copyright (c) 2017, Davood Rasti and Alireza Rasti - rastisoft
+All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#pragma once
+
+#include <GL/glew.h>
+#include <cassert>
+#include <vector>
+#include "RS/Common/CommonTypes.h"
+#include "RS/Graphics/BaseGL/Buffer.h"
+#include "RS/Graphics/BaseGL/VertexArray.h"
+
+namespace RS::Graphics::BaseGL
+{
+    //The command layout read by glMultiDrawElementsIndirect.
+    struct DrawElementsIndirectCommand
+    {
+        ui32                        count;
+        ui32                        instanceCount;
+        ui32                        firstIndex;
+        i32                         baseVertex;
+        ui32                        baseInstance;
+    };
+
+    /**
+        @description: Packs many meshes into one vertex and one index buffer and draws all of them
+        with a single glMultiDrawElementsIndirect (GL 4.3/ARB_multi_draw_indirect). On older
+        contexts the same commands are drawn by a loop of glDrawElementsBaseVertex calls.
+        Meshes are added once, build() uploads the commands and sets up the vertex array.
+        @param TLayout: the VertexLayout of the vertices.
+        @param TIndex: ui8, ui16 or ui32.
+    */
+    template <class TLayout, class TIndex>
+    class IndirectDrawBatch
+    {
+    public:
+        typedef typename TLayout::VertexType VertexType;
+
+    protected:
+        Buffer<VertexType>          mVertexBuffer;
+        Buffer<TIndex>              mIndexBuffer;
+        Buffer<DrawElementsIndirectCommand> mCommandBuffer;
+        VertexArray                 mVertexArray;
+        std::vector<DrawElementsIndirectCommand> mCommands;
+        bool                        mIsIndirectSupported;
+        bool                        mIsCommandBufferDirty{true};
+        bool                        mIsVertexArrayDirty{true};
+
+    public:
+                                    IndirectDrawBatch(void);
+                                    IndirectDrawBatch(const IndirectDrawBatch&) = delete;
+        IndirectDrawBatch&          operator=(const IndirectDrawBatch&) = delete;
+
+        /**
+            @description: Appends a mesh to the shared buffers.
+            @param vertices: the vertices.
+            @param vertexCount: the number of vertices.
+            @param indices: the indices, relative to the first vertex of the mesh.
+            @param indexCount: the number of indices.
+            @param instanceCount: the number of instances to draw, 0 hides the mesh.
+            @return ui32: the mesh index.
+        */
+        ui32                        addMesh(const VertexType* vertices, ui32 vertexCount,
+                                            const TIndex* indices, ui32 indexCount, ui32 instanceCount = 1);
+
+        /**
+            @description: Changes the number of instances of a mesh, 0 hides it.
+            @param meshIndex: the mesh index returned by addMesh().
+            @param instanceCount: the number of instances.
+            @return void.
+        */
+        void                        setInstanceCount(ui32 meshIndex, ui32 instanceCount);
+
+        /**
+            @description: Uploads the changed commands and sets up the vertex array after meshes were added.
+            draw() calls it when needed, calling it at load time keeps the work out of the frame.
+            @return void.
+        */
+        void                        build(void);
+
+        /**
+            @description: Draws all the meshes.
+            @param mode: the primitive type.
+            @return void.
+        */
+        void                        draw(GLenum mode = GL_TRIANGLES);
+
+        //Attaches additional, e.g. per-instance, vertex data to the batch.
+        VertexArray&                getVertexArray(void) noexcept;
+        ui32                        getMeshCount(void) const noexcept;
+        bool                        isIndirectSupported(void) const noexcept;
+    };
+
+    template <class TLayout, class TIndex>
+    IndirectDrawBatch<TLayout, TIndex>::IndirectDrawBatch(void) :
+        mVertexBuffer(GL_ARRAY_BUFFER),
+        mIndexBuffer(GL_ELEMENT_ARRAY_BUFFER),
+        mCommandBuffer(GL_DRAW_INDIRECT_BUFFER),
+        mIsIndirectSupported(GLEW_VERSION_4_3 || GLEW_ARB_multi_draw_indirect)
+    {
+    }
+
+    template <class TLayout, class TIndex>
+    ui32 IndirectDrawBatch<TLayout, TIndex>::addMesh(const VertexType* vertices, ui32 vertexCount,
+                                                     const TIndex* indices, ui32 indexCount, ui32 instanceCount)
+    {
+        assert(vertexCount > 0 && indexCount > 0);
+
+        //append() uploads through GL_COPY_WRITE_BUFFER, so it leaves the element array buffer of the
+        //bound vertex array alone. When it grows a buffer the object is replaced, and the vertex array
+        //is set up again in build().
+        const ui32 vertexGeneration = mVertexBuffer.getGeneration();
+        const ui32 indexGeneration = mIndexBuffer.getGeneration();
+        const ui32 vertexOffset = mVertexBuffer.append(vertices, vertexCount * sizeof(VertexType));
+        const ui32 indexOffset = mIndexBuffer.append(indices, indexCount * sizeof(TIndex));
+
+        mCommands.push_back({indexCount, instanceCount, indexOffset / static_cast<ui32>(sizeof(TIndex)),
+                             static_cast<i32>(vertexOffset / sizeof(VertexType)), 0});
+        mIsCommandBufferDirty = true;
+        if(mVertexBuffer.getGeneration() != vertexGeneration || mIndexBuffer.getGeneration() != indexGeneration)
+            mIsVertexArrayDirty = true;
+
+        return static_cast<ui32>(mCommands.size() - 1);
+    }
+
+    template <class TLayout, class TIndex>
+    RS_INLINE void IndirectDrawBatch<TLayout, TIndex>::setInstanceCount(ui32 meshIndex, ui32 instanceCount)
+    {
+        assert(meshIndex < mCommands.size());
+
+        if(mCommands[meshIndex].instanceCount != instanceCount)
+        {
+            mCommands[meshIndex].instanceCount = instanceCount;
+            mIsCommandBufferDirty = true;
+        }
+    }
+
+    template <class TLayout, class TIndex>
+    void IndirectDrawBatch<TLayout, TIndex>::build(void)
+    {
+        if(mIsVertexArrayDirty)
+        {
+            //The buffers are attached to the batch's own vertex array, whatever vertex array
+            //another batch left bound is not touched.
+            mVertexArray.bind();
+            mVertexArray.addVertexBuffer<TLayout>(mVertexBuffer);
+            mVertexArray.setIndexBuffer(mIndexBuffer);
+            mIsVertexArrayDirty = false;
+        }
+
+        if(mIsCommandBufferDirty && mIsIndirectSupported)
+            mCommandBuffer.set(mCommands.data(), mCommands.size() * sizeof(DrawElementsIndirectCommand));
+
+        mIsCommandBufferDirty = false;
+    }
+
+    template <class TLayout, class TIndex>
+    void IndirectDrawBatch<TLayout, TIndex>::draw(GLenum mode)
+    {
+        if(mCommands.empty())
+            return;
+
+        build();
+        //Bound explicitly for every draw, build() may have returned without binding it.
+        mVertexArray.bind();
+
+        const GLenum indexType = mVertexArray.getIndexType();
+        if(mIsIndirectSupported)
+        {
+            mCommandBuffer.bind();
+            glMultiDrawElementsIndirect(mode, indexType, nullptr, static_cast<GLsizei>(mCommands.size()), 0);
+            return;
+        }
+
+        for(const auto& command : mCommands)
+        {
+            if(command.instanceCount == 0)
+                continue;
+
+            const auto indices = reinterpret_cast<const void*>(static_cast<GLintptr>(command.firstIndex) * sizeof(TIndex));
+            if(command.instanceCount == 1)
+                glDrawElementsBaseVertex(mode, command.count, indexType, indices, command.baseVertex);
+            else
+                glDrawElementsInstancedBaseVertex(mode, command.count, indexType, indices, command.instanceCount, command.baseVertex);
+        }
+    }
+
+    template <class TLayout, class TIndex>
+    RS_INLINE VertexArray& IndirectDrawBatch<TLayout, TIndex>::getVertexArray(void) noexcept
+    {
+        return mVertexArray;
+    }
+
+    template <class TLayout, class TIndex>
+    RS_INLINE ui32 IndirectDrawBatch<TLayout, TIndex>::getMeshCount(void) const noexcept
+    {
+        return static_cast<ui32>(mCommands.size());
+    }
+
+    template <class TLayout, class TIndex>
+    RS_INLINE bool IndirectDrawBatch<TLayout, TIndex>::isIndirectSupported(void) const noexcept
+    {
+        return mIsIndirectSupported;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,139 @@
+/*
+BSD 2-Clause License
+Copyright (c) 2017, Davood Rasti and Alireza Rasti - rastisoft
+All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#pragma once
+
+#include <GL/glew.h>
+#include <string>
+#include <string_view>
+#include "RS/Common/CommonTypes.h"
+
+namespace RS::Graphics::BaseGL
+{
+    /**
+        @description: Stores linked programs on disk with glGetProgramBinary and restores them with
+        glProgramBinary, so a program is compiled from source only the first time. Entries are keyed
+        by a hash of the program sources (including injected defines) and of the GL vendor, renderer
+        and version strings, so a driver update misses the old entries instead of loading them. A
+        binary that the driver rejects is deleted and the program is compiled from source again.
+    */
+    class ProgramBinaryCache
+    {
+    protected:
+        std::string                 mDirectory;
+        ui64                        mDriverHash{0};
+        ui64                        mHitCount{0};
+        ui64                        mMissCount{0};
+        bool                        mIsSupported{false};
+        bool                        mIsInitialized{false};
+
+        void                        initialize(void);
+        std::string                 getFilePath(ui64 key) const;
+
+    public:
+        /**
+            @description: FNV-1a 64 bit hash.
+            @param data: the data to hash.
+            @param hash: the hash to continue from.
+            @return ui64.
+        */
+        static ui64                 hash(std::string_view data, ui64 hash = 14695981039346656037ull) noexcept;
+
+        /**
+            @description: ProgramBinaryCache constructor.
+            @param directory: the cache directory, an empty string disables the cache.
+            @return
+        */
+                                    ProgramBinaryCache(const std::string& directory = "");
+
+        void                        setDirectory(const std::string& directory);
+        const std::string&          getDirectory(void) const noexcept;
+
+        /**
+            @description: Whether entries can be loaded/stored: a directory is set and the context
+            supports program binaries (GL 4.1/ARB_get_program_binary) in at least one format.
+            It needs a current context.
+            @return bool.
+        */
+        bool                        isEnabled(void);
+
+        /**
+            @description: Returns the key of a program, it covers the driver as well.
+            @param sourcesHash: the hash of the program sources.(see hash())
+            @return ui64.
+        */
+        ui64                        getKey(ui64 sourcesHash);
+
+        /**
+            @description: Must be called before linking a program that will be stored.
+            @param program: the program name.
+            @return void.
+        */
+        void                        prepare(GLuint program);
+
+        /**
+            @description: Loads the binary of key into program.
+            @param key: the program key.
+            @param program: a program without attached shaders.
+            @return bool: true if the program was loaded and linked successfully.
+        */
+        bool                        load(ui64 key, GLuint program);
+
+        /**
+            @description: Stores the binary of a linked program.
+            @param key: the program key.
+            @param program: the program name.
+            @return void.
+        */
+        void                        store(ui64 key, GLuint program);
+
+        ui64                        getHitCount(void) const noexcept;
+        ui64                        getMissCount(void) const noexcept;
+    };
+
+    RS_INLINE ui64 ProgramBinaryCache::hash(std::string_view data, ui64 hash) noexcept
+    {
+        for(const char character : data)
+        {
+            hash ^= static_cast<ui8>(character);
+            hash *= 1099511628211ull;
+        }
+
+        return hash;
+    }
+
+    RS_INLINE const std::string& ProgramBinaryCache::getDirectory(void) const noexcept
+    {
+        return mDirectory;
+    }
+
+    RS_INLINE ui64 ProgramBinaryCache::getHitCount(void) const noexcept
+    {
+        return mHitCount;
+    }
+
+    RS_INLINE ui64 ProgramBinaryCache::getMissCount(void) const noexcept
+    {
+        return mMissCount;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,200 @@
+/*
+BSD 2-Clause License
+Copyright (c) 2017, Davood Rasti and Alireza Rasti - rastisoft
+All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#pragma once
+
+#include <GL/glew.h>
+#include <array>
+#include <vector>
+#include "RS/Common/CommonTypes.h"
+
+namespace RS::Graphics::BaseGL
+{
+    class Shader;
+
+    //A draw call along with the state it needs.
+    struct DrawPacket
+    {
+        static constexpr ui32       maxTextures{4};
+
+        ui64                        sortKey{0};
+        //The uniforms are set through the shader, so its record of uniform values stays right.
+        Shader*                     shader{nullptr};
+        GLuint                      vertexArray{0};
+        //Textures bound to units 0 to maxTextures - 1, 0 leaves a unit untouched.
+        std::array<GLuint, maxTextures> textures{};
+        GLenum                      primitive{GL_TRIANGLES};
+        //GL_UNSIGNED_BYTE/SHORT/INT for glDrawElements, 0 for glDrawArrays.
+        GLenum                      indexType{0};
+        GLsizei                     count{0};
+        //The byte offset into the index buffer, or the first vertex for glDrawArrays.
+        GLintptr                    offset{0};
+        ui32                        uniformBegin{0};
+        ui32                        uniformCount{0};
+    };
+
+    /**
+        @description: Records draw packets under 64-bit sort keys, radix-sorts them and submits
+        them with as few state changes as possible.
+
+        Key layout (most significant bits first):
+        8 bits layer | 1 bit translucent |
+        opaque:      15 bits program | 16 bits state (e.g. texture/material) | 24 bits depth, near first.
+        translucent: 24 bits depth, far first | 15 bits program | 16 bits state.
+        Layers are submitted in order, opaque packets before translucent ones of the same layer.
+    */
+    class RenderQueue
+    {
+    protected:
+        struct UniformCommand
+        {
+            GLint                   location;
+            GLenum                  type;
+            GLsizei                 count;
+            ui32                    dataOffset;
+        };
+
+        struct SortEntry
+        {
+            ui64                    key;
+            ui32                    packetIndex;
+        };
+
+        std::vector<DrawPacket>     mPackets;
+        std::vector<UniformCommand> mUniforms;
+        std::vector<ui8>            mUniformData;
+        std::vector<SortEntry>      mSortEntries;
+        std::vector<SortEntry>      mSortBuffer;
+        bool                        mIsSorted{false};
+        //The blend function of the translucent packets.
+        GLenum                      mSourceBlendFactor{GL_SRC_ALPHA};
+        GLenum                      mDestinationBlendFactor{GL_ONE_MINUS_SRC_ALPHA};
+
+        static ui32                 quantizeDepth(f32 depth) noexcept;
+        void                        applyUniform(Shader& shader, const UniformCommand& uniform);
+
+    public:
+        static constexpr ui64       translucentBit{1ull << 55};
+
+        /**
+            @description: Builds a key that sorts opaque draws by state and then front-to-back.
+            @param layer: draws of lower layers are submitted first.
+            @param program: the program, only the lower 15 bits are used.
+            @param state: the texture/material id, only the lower 16 bits are used.
+            @param depth: the normalized view depth in [0, 1].
+            @return ui64.
+        */
+        static ui64                 makeOpaqueKey(ui8 layer, GLuint program, ui32 state, f32 depth) noexcept;
+
+        /**
+            @description: Builds a key that sorts translucent draws back-to-front.
+            @param layer: draws of lower layers are submitted first.
+            @param program: the program, only the lower 15 bits are used.
+            @param state: the texture/material id, only the lower 16 bits are used.
+            @param depth: the normalized view depth in [0, 1].
+            @return ui64.
+        */
+        static ui64                 makeTranslucentKey(ui8 layer, GLuint program, ui32 state, f32 depth) noexcept;
+
+        /**
+            @description: Adds a packet, the uniforms added afterwards belong to it.
+            @param packet: the packet, its uniform range is set by the queue.
+            @return void.
+        */
+        void                        add(const DrawPacket& packet);
+
+        /**
+            @description: Adds a uniform value to the last added packet. The value is copied.
+            @param location: the uniform location.
+            @param type: GL_FLOAT, GL_FLOAT_VEC2/3/4, GL_INT, GL_FLOAT_MAT3 or GL_FLOAT_MAT4.
+            @param data: the value(s).
+            @param count: the number of array elements.
+            @return void.
+        */
+        void                        addUniform(GLint location, GLenum type, const void* data, GLsizei count = 1);
+
+        /**
+            @description: Sets the blend function of the translucent packets.(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA by default)
+            @param sourceFactor: the source factor.
+            @param destinationFactor: the destination factor.
+            @return void.
+        */
+        void                        setBlendFunc(GLenum sourceFactor, GLenum destinationFactor) noexcept;
+
+        /**
+            @description: Sorts the packets by their keys with an LSD radix sort. Byte positions
+            that are equal in all keys are skipped.
+            @return void.
+        */
+        void                        sort(void);
+
+        /**
+            @description: Sorts the packets if needed and issues them. Opaque packets are drawn
+            with blending disabled, translucent ones with blending enabled, the blend function of
+            the queue and depth writes off. On return blending is enabled or disabled as it was
+            before and depth writes are enabled; the blend function is left at the one of the
+            queue if there were translucent packets, and the program, vertex array and textures
+            of the last packet stay bound.
+            @return void.
+        */
+        void                        submit(void);
+
+        void                        clear(void);
+        ui32                        getPacketCount(void) const noexcept;
+    };
+
+    RS_INLINE ui32 RenderQueue::quantizeDepth(f32 depth) noexcept
+    {
+        constexpr f32 maxDepth = static_cast<f32>((1u << 24) - 1);
+        depth = (depth < 0.0f) ? 0.0f : ((depth > 1.0f) ? 1.0f : depth);
+
+        return static_cast<ui32>(depth * maxDepth);
+    }
+
+    RS_INLINE ui64 RenderQueue::makeOpaqueKey(ui8 layer, GLuint program, ui32 state, f32 depth) noexcept
+    {
+        return (static_cast<ui64>(layer) << 56) |
+               (static_cast<ui64>(program & 0x7FFF) << 40) |
+               (static_cast<ui64>(state & 0xFFFF) << 24) |
+               quantizeDepth(depth);
+    }
+
+    RS_INLINE ui64 RenderQueue::makeTranslucentKey(ui8 layer, GLuint program, ui32 state, f32 depth) noexcept
+    {
+        return (static_cast<ui64>(layer) << 56) | translucentBit |
+               (static_cast<ui64>(0xFFFFFF - quantizeDepth(depth)) << 31) |
+               (static_cast<ui64>(program & 0x7FFF) << 16) |
+               (state & 0xFFFF);
+    }
+
+    RS_INLINE void RenderQueue::setBlendFunc(GLenum sourceFactor, GLenum destinationFactor) noexcept
+    {
+        mSourceBlendFactor = sourceFactor;
+        mDestinationBlendFactor = destinationFactor;
+    }
+
+    RS_INLINE ui32 RenderQueue::getPacketCount(void) const noexcept
+    {
+        return mPackets.size();
+    }
+}
\ No newline at end of file
@@ -24,47 +24,277 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #pragma once
 
 #include <GL/glew.h>
+#include <cassert>
 #include <string>
+#include <string_view>
 #include <unordered_map>
+#include <vector>
 #include "RS/Common/CommonTypes.h"
 #include "RS/Common/RSErrorCode.h"
+#include "RS/Graphics/BaseGL/GLStateCache.h"
+#include "RS/Graphics/BaseGL/ProgramBinaryCache.h"
 
 #include <iostream>
 
 namespace RS::Graphics::BaseGL
 {
+    /**
+        @description: Refers to a uniform added by Shader::addUniform(). Setting a uniform through its
+        handle is an array access, there is no hashing or string construction.
+    */
+    struct UniformHandle
+    {
+        static constexpr ui32 invalidIndex{~0u};
+
+        ui32        index{invalidIndex};
+
+        bool        isValid(void) const noexcept { return index != invalidIndex; }
+    };
+
+    //An active uniform or attribute of a linked program. Arrays are listed by their name without
+    //"[0]" and each later element as "name[i]", size is the number of elements from there on.
+    struct ShaderVariable
+    {
+        std::string name;
+        GLint       location;
+        GLenum      type;
+        GLint       size;
+    };
+
+    //An active uniform block of a linked program.
+    struct ShaderUniformBlock
+    {
+        std::string name;
+        GLuint      index;
+        //In bytes.
+        GLint       dataSize;
+    };
+
     class Shader
     {
     protected:
-        std::unordered_map<std::string, GLint> uniformLocationsList;
+        struct UniformValue
+        {
+            //Byte range of the value in mUniformValueData, size is 0 for types that are not shadowed.
+            ui32    offset;
+            ui32    size;
+            bool    isSet;
+        };
+
+        //Locations of the added uniforms, indexed by UniformHandle::index.
+        std::vector<GLint>                      mUniformLocations;
+        //Types of the added uniforms for the debug checks of the setters, 0 if not active.
+        std::vector<GLenum>                     mUniformTypes;
+        std::vector<std::string>                mUniformNames;
+        std::unordered_map<std::string, ui32>   mUniformIndices;
+        //Binding points of the uniform blocks, set again after every link.
+        std::vector<std::pair<std::string, ui32>> mUniformBlockBindings;
+        //Reflection of the linked program, sorted by name.
+        std::vector<ShaderVariable>             mActiveUniforms;
+        std::vector<ShaderVariable>             mActiveAttributes;
+        std::vector<ShaderUniformBlock>         mActiveUniformBlocks;
+        //Last value written to each uniform location, indexed by location.
+        std::vector<UniformValue>               mUniformValues;
+        std::vector<ui8>                        mUniformValueData;
+        //Names of missing uniforms that were already reported, cleared by reflect().
+        mutable std::vector<std::string>        mReportedUniforms;
+        ui64        mIssuedUniformCount{0};
+        ui64        mSkippedUniformCount{0};
         bool        mIsCompiled{false};
         ui32        mProgramHandle{0};
-        ui32        mVertexShaderHandle;
-        ui32        mFragmentShaderHandle;
+        ui32        mVertexShaderHandle{0};
+        ui32        mFragmentShaderHandle{0};
+        //Where the binary goes once a build started by beginCompileAndLink() has finished.
+        ProgramBinaryCache* mPendingBinaryCache{nullptr};
+        ui64        mPendingProgramKey{0};
         
         void        loadFile(const std::string_view& fileAddress, std::string* outString);
+        //Hands the program and shader objects over to the deletion queue.
+        void        release(void);
+        //Reads the active uniforms, attributes and uniform blocks of the linked program.
+        void        reflect(void);
+        //Reflects the program and looks the added uniforms up again and rebinds the uniform blocks
+        //after (re)linking, so their handles and bindings stay valid.
+        void        resolveUniforms(void);
+        /**
+            @description: Compares a value with the last one written to location and records it.
+            @param location: the uniform location.
+            @param value: the value.
+            @param size: the size of one element in bytes.
+            @param count: the number of array elements written.
+            @param isTransposed: whether a matrix is written transposed.
+            Array and transposed writes are not tracked, they forget the recorded values of the
+            locations they write.(location to location + count - 1)
+            @return bool: whether the glUniform* call must be issued.
+        */
+        bool        updateUniformValue(GLint location, const void* value, ui32 size, GLsizei count = 1, bool isTransposed = false);
+        //Whether a setter for setterType may write the added uniform index, true if it is not active.
+        bool        isUniformTypeCompatible(ui32 index, GLenum setterType) const noexcept;
+        //Looks the name up in the added uniforms, then in the reflection; -1 if the program does not have it.
+        GLint       findUniformLocation(const std::string& uniform, GLenum setterType) const;
+        //Reports a name the program has no active uniform for once, in debug builds only.
+        void        reportMissingUniform(const std::string& uniform) const;
         ui32        compileShader(const std::string_view& shaderCode, ui32 shaderType);
+        void        checkCompileStatus(ui32 shaderHandle);
+        void        checkLinkStatus(void);
 
     public:
                     Shader(void) = default;
+                    Shader(const Shader&) = delete;
+                    Shader(Shader&& other) noexcept;
+        Shader&     operator=(const Shader&) = delete;
+        Shader&     operator=(Shader&& other) noexcept;
         virtual     ~Shader(void);
 
         void        link(void);
-        void        loadCompileAndLink(const std::string_view& vertexShaderFile, const std::string_view& fragmentShaderFile);
+        /**
+            @description: Loads the sources of the program and builds it.(see compileAndLink())
+            @param vertexShaderFile: the vertex shader file.
+            @param fragmentShaderFile: the fragment shader file.
+            @param programBinaryCache: the cache to restore/store the program binary, nullptr for none.
+            @return void.
+        */
+        void        loadCompileAndLink(const std::string_view& vertexShaderFile, const std::string_view& fragmentShaderFile,
+                                       ProgramBinaryCache* programBinaryCache = nullptr);
+
+        /**
+            @description: Builds the program from source. With a cache the program binary is restored
+            from it if possible, otherwise the program is compiled and its binary is stored.
+            @param vertexShaderCode: the vertex shader source.
+            @param fragmentShaderCode: the fragment shader source.
+            @param programBinaryCache: the cache to restore/store the program binary, nullptr for none.
+            @return void.
+        */
+        void        compileAndLink(const std::string_view& vertexShaderCode, const std::string_view& fragmentShaderCode,
+                                   ProgramBinaryCache* programBinaryCache = nullptr);
+
+        /**
+            @description: Starts building the program without waiting for the driver: the stages are
+            compiled and linked but no status is queried. finishCompileAndLink() must follow.
+            @param vertexShaderCode: the vertex shader source.
+            @param fragmentShaderCode: the fragment shader source.
+            @param programBinaryCache: the cache to restore/store the program binary, nullptr for none.
+            @return void.
+        */
+        void        beginCompileAndLink(const std::string_view& vertexShaderCode, const std::string_view& fragmentShaderCode,
+                                        ProgramBinaryCache* programBinaryCache = nullptr);
+
+        /**
+            @description: Returns whether finishCompileAndLink() would not block. Without
+            KHR/ARB_parallel_shader_compile it is always true, the driver then blocks in finishCompileAndLink().
+            @return bool.
+        */
+        bool        isBuildComplete(void);
+
+        /**
+            @description: Checks the compile and link status of a build started by beginCompileAndLink(),
+            throws with the info log on failure, and resolves the uniforms.
+            @return void.
+        */
+        void        finishCompileAndLink(void);
+
+        /**
+            @description: Replaces the program with the one built by other, which is left empty. The
+            old program is released and the added uniforms are looked up in the new one, so their
+            handles stay valid. The values last written to uniforms that are still active with the
+            same type are written to the new program, which is left in use if there were any; array
+            and transposed writes are not recorded and must be set again.
+            @param other: a shader whose build has finished.
+            @return void.
+        */
+        void        adoptProgram(Shader&& other);
+
+        bool        isCompiled(void) const noexcept;
+        static bool isParallelCompileSupported(void);
         void        use(void);
 
         void        bindAttribLocation(GLint location, const std::string& attribute);
-        RSErrorCode addUniform(const std::string& uniform);
 
+        /**
+            @description: Looks a uniform up once and returns its handle. Adding a name again returns
+            the same handle. A name that the program does not use gets a handle whose setters do nothing;
+            like the name based setters, debug builds report it once to std::cerr.
+            @param uniform: the uniform name.
+            @return UniformHandle: an invalid handle if the program has not been created.
+        */
+        UniformHandle addUniform(const std::string& uniform);
+        //Returns the handle of an added uniform, or an invalid handle.
+        UniformHandle getUniformHandle(const std::string& uniform) const;
+        GLint       getUniformLocation(UniformHandle uniform) const noexcept;
+
+        //The setters skip the driver call if the uniform already has the value.
+        void        setUniformMatrix4fv(UniformHandle uniform, const GLfloat* value, GLsizei count = 1, GLboolean transpose = GL_FALSE);
+        void        setUniformMatrix3fv(UniformHandle uniform, const GLfloat* value, GLsizei count = 1, GLboolean transpose = GL_FALSE);
+        void        setUniform3f(UniformHandle uniform, GLfloat value1, GLfloat value2, GLfloat value3);
+        void        setUniform1f(UniformHandle uniform, GLfloat value);
+        void        setUniform1i(UniformHandle uniform, GLint value);
+
+        //Name based setters, they hash the name on every call. Names that were not added are looked up in the
+        //reflection of the program. Names the program does not have, e.g. uniforms the compiler optimized out or
+        //an #ifdef removed, are ignored; debug builds report each of them once to std::cerr.
         void        setUniformMatrix4fv(const std::string& uniform, const GLfloat* value, GLsizei count = 1, GLboolean transpose = GL_FALSE);
         void        setUniformMatrix3fv(const std::string& uniform, const GLfloat* value, GLsizei count = 1, GLboolean transpose = GL_FALSE);
         void        setUniform3f(const std::string& uniform, GLfloat value1, GLfloat value2, GLfloat value3);
         void        setUniform1f(const std::string& uniform, GLfloat value);
         void        setUniform1i(const std::string& uniform, GLint value);
 
+        /**
+            @description: Location based setter for recorded uniform values.(see RenderQueue)
+            @param location: the uniform location.
+            @param type: GL_FLOAT, GL_FLOAT_VEC2/3/4, GL_INT, GL_FLOAT_MAT3 or GL_FLOAT_MAT4.
+            @param value: the value(s).
+            @param count: the number of array elements.
+            @return void.
+        */
+        void        setUniform(GLint location, GLenum type, const void* value, GLsizei count = 1);
+
+        /**
+            @description: Binds a uniform block of the program to a binding point of GL_UNIFORM_BUFFER
+            (see UniformBlock). The binding is kept when the program is linked again.
+            @param uniformBlock: the block name.
+            @param bindingPoint: the binding point.
+            @return bool: false if the program has no such block.
+        */
+        bool        bindUniformBlock(const std::string& uniformBlock, ui32 bindingPoint);
+
+        /**
+            @description: Returns the active uniforms/attributes/uniform blocks of the linked program,
+            sorted by name. They are read once after every link.
+            @return const std::vector&.
+        */
+        const std::vector<ShaderVariable>&     getActiveUniforms(void) const noexcept;
+        const std::vector<ShaderVariable>&     getActiveAttributes(void) const noexcept;
+        const std::vector<ShaderUniformBlock>& getActiveUniformBlocks(void) const noexcept;
+
+        /**
+            @description: Looks a name up in the reflection of the program, the driver is not queried.
+            @param name: the uniform/attribute name, an array element may be given as "name[i]".
+            @return const ShaderVariable*: nullptr if it is not active.
+        */
+        const ShaderVariable*     findUniform(const std::string_view& name) const;
+        const ShaderVariable*     findAttribute(const std::string_view& name) const;
+        const ShaderUniformBlock* findUniformBlock(const std::string_view& name) const;
+
+        /**
+            @description: Forgets the recorded uniform values, so the next setter calls are issued. It must be
+            called after uniforms of the program are written by glUniform* calls outside this class.
+            @return void.
+        */
+        void        invalidateUniformValues(void);
+
+        /**
+            @description: Returns the number of setter calls that reached the driver and the number that
+            were skipped because the uniform already had the value.
+            @return ui64.
+        */
+        ui64        getIssuedUniformCount(void) const noexcept;
+        ui64        getSkippedUniformCount(void) const noexcept;
+        void        resetUniformCounters(void) noexcept;
+
         ui32        getProgramHandle(void);
-        GLint       getAttribLocation(const std::string_view& attribute);
-        GLint       getUniformLocation(const std::string_view& uniform);
+        //-1 if the attribute/uniform is not active.
+        GLint       getAttribLocation(const std::string_view& attribute) const;
+        GLint       getUniformLocation(const std::string_view& uniform) const;
     };
 
     RS_INLINE void Shader::bindAttribLocation(GLint location, const std::string& attribute)
@@ -72,30 +302,107 @@ namespace RS::Graphics::BaseGL
         glBindAttribLocation(mProgramHandle, location, attribute.c_str());
     }
 
+    RS_INLINE GLint Shader::getUniformLocation(UniformHandle uniform) const noexcept
+    {
+        return uniform.index < mUniformLocations.size() ? mUniformLocations[uniform.index] : -1;
+    }
+
+    RS_INLINE void Shader::setUniformMatrix4fv(UniformHandle uniform, const GLfloat* value, GLsizei count, GLboolean transpose)
+    {
+        assert(isUniformTypeCompatible(uniform.index, GL_FLOAT_MAT4));
+        const GLint location = getUniformLocation(uniform);
+        if(updateUniformValue(location, value, sizeof(GLfloat) * 16, count, transpose != GL_FALSE))
+            glUniformMatrix4fv(location, count, transpose, value);
+    }
+
+    RS_INLINE void Shader::setUniformMatrix3fv(UniformHandle uniform, const GLfloat* value, GLsizei count, GLboolean transpose)
+    {
+        assert(isUniformTypeCompatible(uniform.index, GL_FLOAT_MAT3));
+        const GLint location = getUniformLocation(uniform);
+        if(updateUniformValue(location, value, sizeof(GLfloat) * 9, count, transpose != GL_FALSE))
+            glUniformMatrix3fv(location, count, transpose, value);
+    }
+
+    RS_INLINE void Shader::setUniform3f(UniformHandle uniform, GLfloat value1, GLfloat value2, GLfloat value3)
+    {
+        assert(isUniformTypeCompatible(uniform.index, GL_FLOAT_VEC3));
+        const GLint location = getUniformLocation(uniform);
+        const GLfloat value[] = {value1, value2, value3};
+        if(updateUniformValue(location, value, sizeof(value)))
+            glUniform3f(location, value1, value2, value3);
+    }
+
+    RS_INLINE void Shader::setUniform1f(UniformHandle uniform, GLfloat value)
+    {
+        assert(isUniformTypeCompatible(uniform.index, GL_FLOAT));
+        const GLint location = getUniformLocation(uniform);
+        if(updateUniformValue(location, &value, sizeof(value)))
+            glUniform1f(location, value);
+    }
+
+    RS_INLINE void Shader::setUniform1i(UniformHandle uniform, GLint value)
+    {
+        assert(isUniformTypeCompatible(uniform.index, GL_INT));
+        const GLint location = getUniformLocation(uniform);
+        if(updateUniformValue(location, &value, sizeof(value)))
+            glUniform1i(location, value);
+    }
+
     RS_INLINE void Shader::setUniformMatrix4fv(const std::string& uniform, const GLfloat* value, GLsizei count, GLboolean transpose)
     {
-        glUniformMatrix4fv(uniformLocationsList[uniform] , count, transpose, value);
-        // std::cout << uniformLocationsList[uniform] << "--\n";
+        const GLint location = findUniformLocation(uniform, GL_FLOAT_MAT4);
+        if(updateUniformValue(location, value, sizeof(GLfloat) * 16, count, transpose != GL_FALSE))
+            glUniformMatrix4fv(location, count, transpose, value);
     }
 
     RS_INLINE void Shader::setUniformMatrix3fv(const std::string& uniform, const GLfloat* value, GLsizei count, GLboolean transpose)
     {
-        glUniformMatrix3fv(uniformLocationsList[uniform] , count, transpose, value);
+        const GLint location = findUniformLocation(uniform, GL_FLOAT_MAT3);
+        if(updateUniformValue(location, value, sizeof(GLfloat) * 9, count, transpose != GL_FALSE))
+            glUniformMatrix3fv(location, count, transpose, value);
     }
 
     RS_INLINE void Shader::setUniform3f(const std::string& uniform, GLfloat value1, GLfloat value2, GLfloat value3)
     {
-        glUniform3f(uniformLocationsList[uniform], value1, value2, value3);
+        const GLint location = findUniformLocation(uniform, GL_FLOAT_VEC3);
+        const GLfloat value[] = {value1, value2, value3};
+        if(updateUniformValue(location, value, sizeof(value)))
+            glUniform3f(location, value1, value2, value3);
     }
 
     RS_INLINE void Shader::setUniform1f(const std::string& uniform, GLfloat value)
     {
-        glUniform1f(uniformLocationsList[uniform], value);
+        const GLint location = findUniformLocation(uniform, GL_FLOAT);
+        if(updateUniformValue(location, &value, sizeof(value)))
+            glUniform1f(location, value);
     }
 
     RS_INLINE void Shader::setUniform1i(const std::string& uniform, GLint value)
     {
-        glUniform1i(uniformLocationsList[uniform], value);
+        const GLint location = findUniformLocation(uniform, GL_INT);
+        if(updateUniformValue(location, &value, sizeof(value)))
+            glUniform1i(location, value);
+    }
+
+    RS_INLINE ui64 Shader::getIssuedUniformCount(void) const noexcept
+    {
+        return mIssuedUniformCount;
+    }
+
+    RS_INLINE ui64 Shader::getSkippedUniformCount(void) const noexcept
+    {
+        return mSkippedUniformCount;
+    }
+
+    RS_INLINE void Shader::resetUniformCounters(void) noexcept
+    {
+        mIssuedUniformCount = 0;
+        mSkippedUniformCount = 0;
+    }
+
+    RS_INLINE bool Shader::isCompiled(void) const noexcept
+    {
+        return mIsCompiled;
     }
 
     RS_INLINE ui32 Shader::getProgramHandle(void)
@@ -105,16 +412,33 @@ namespace RS::Graphics::BaseGL
 
     RS_INLINE void Shader::use(void)
     {
-        glUseProgram(mProgramHandle);
+        GLStateCache::getCurrent().useProgram(mProgramHandle);
+    }
+
+    RS_INLINE const std::vector<ShaderVariable>& Shader::getActiveUniforms(void) const noexcept
+    {
+        return mActiveUniforms;
+    }
+
+    RS_INLINE const std::vector<ShaderVariable>& Shader::getActiveAttributes(void) const noexcept
+    {
+        return mActiveAttributes;
+    }
+
+    RS_INLINE const std::vector<ShaderUniformBlock>& Shader::getActiveUniformBlocks(void) const noexcept
+    {
+        return mActiveUniformBlocks;
     }
 
-    RS_INLINE GLint Shader::getAttribLocation(const std::string_view& attribute)
+    RS_INLINE GLint Shader::getAttribLocation(const std::string_view& attribute) const
     {
-        return glGetAttribLocation(mProgramHandle, &attribute[0]);
+        const auto* variable = findAttribute(attribute);
+        return variable ? variable->location : -1;
     }
 
-    RS_INLINE GLint Shader::getUniformLocation(const std::string_view& uniform)
+    RS_INLINE GLint Shader::getUniformLocation(const std::string_view& uniform) const
     {
-        return glGetUniformLocation(mProgramHandle, &uniform[0]);
+        const auto* variable = findUniform(uniform);
+        return variable ? variable->location : -1;
     }
 }
\ No newline at end of file
@@ -0,0 +1,190 @@
+/*
+BSD 2-Clause License
+Copyright (c) 2017, Davood Rasti and Alireza Rasti - rastisoft
+All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "RS/Common/CommonTypes.h"
+#include "RS/Graphics/BaseGL/Shader.h"
+#include "RS/Graphics/BaseGL/ShaderPreprocessor.h"
+
+namespace RS::Graphics::BaseGL
+{
+    /**
+        @description: Rebuilds watched programs when their source files change. A background thread
+        waits for file changes (inotify, Linux only) and reads the new sources; update(), called at a
+        frame boundary on the thread that owns the context, builds them without blocking (see
+        Shader::beginCompileAndLink()) and swaps the new program into the Shader once it has linked,
+        keeping its uniform handles. A program that fails to build is dropped and the old one keeps
+        running. On other platforms only requestReload() triggers a reload.
+        Programs watched with a ShaderPreprocessor are expanded again by update() with their defines,
+        after the changed files are invalidated in the preprocessor; their includes are watched too.
+        Without KHR/ARB_parallel_shader_compile a build is finished one update() after it started and
+        finishCompileAndLink() may still block that frame, such hitches are counted by getBlockingBuildCount().
+        mMutex guards what the watcher thread shares(watched programs and pending sources), the
+        pending builds are only touched on the context thread.
+    */
+    class ShaderHotReloader
+    {
+    public:
+        //Reports a finished reload, message is the build error if it failed.
+        typedef std::function<void(const Shader& shader, bool isSucceeded, const std::string& message)> ReloadCallback;
+
+    protected:
+        struct WatchedProgram
+        {
+            Shader*                 shader;
+            std::string             vertexShaderFile;
+            std::string             fragmentShaderFile;
+            //Expands the files, nullptr for plain files.
+            ShaderPreprocessor*     preprocessor;
+            std::vector<std::string> defines;
+            //Canonical paths of the files the program is built from.(the shader files and their includes)
+            std::vector<std::string> files;
+        };
+
+        struct PendingSources
+        {
+            Shader*                 shader;
+            //Read by the watcher thread for plain files.
+            std::string             vertexShaderCode;
+            std::string             fragmentShaderCode;
+            //For preprocessed programs update() expands the files, after invalidating changedFiles.
+            ShaderPreprocessor*     preprocessor;
+            std::vector<std::string> defines;
+            std::string             vertexShaderFile;
+            std::string             fragmentShaderFile;
+            std::vector<std::string> changedFiles;
+        };
+
+        struct PendingBuild
+        {
+            Shader*                 shader;
+            std::unique_ptr<Shader> newShader;
+        };
+
+        std::vector<WatchedProgram> mWatchedPrograms;
+        //Filled by the watcher thread, taken by update().
+        std::vector<PendingSources> mPendingSources;
+        //Only touched on the context thread.(update(), unwatch())
+        std::vector<PendingBuild>   mPendingBuilds;
+        std::mutex                  mMutex;
+        std::thread                 mWatcherThread;
+        std::atomic<bool>           mIsRunning{false};
+        ReloadCallback              mReloadCallback;
+        ui64                        mReloadCount{0};
+        ui64                        mFailedReloadCount{0};
+        ui64                        mBlockingBuildCount{0};
+
+        void                        watcherLoop(void);
+        //Reads the sources of the programs that use file, mMutex must be locked.
+        void                        queueSources(const std::string& file);
+        //Queues a reload of program after file changed, mMutex must be locked.
+        void                        queueProgram(const WatchedProgram& program, const std::string& file);
+        //Expands the sources of a preprocessed program on the context thread, false if it failed.
+        bool                        expandSources(PendingSources& sources);
+        void                        reportReload(const Shader& shader, bool isSucceeded, const std::string& message);
+
+    public:
+                                    ShaderHotReloader(void) = default;
+                                    ShaderHotReloader(const ShaderHotReloader&) = delete;
+        ShaderHotReloader&          operator=(const ShaderHotReloader&) = delete;
+        virtual                     ~ShaderHotReloader(void);
+
+        /**
+            @description: Watches/unwatches the source files of a program. The shader must be unwatched
+            before it is destroyed, unwatch() must be called on the thread that owns the context since it
+            drops the builds of the program. With a preprocessor, watch() must be called on that thread
+            too, since it loads the files to find their includes.
+            @param shader: the program to rebuild.
+            @param vertexShaderFile: the vertex shader file.
+            @param fragmentShaderFile: the fragment shader file.
+            @param preprocessor: expands the files, nullptr to build them as they are. It must outlive the watch.
+            @param defines: the defines the files are expanded with.(see ShaderPreprocessor::expand())
+            @return void.
+        */
+        void                        watch(Shader& shader, const std::string& vertexShaderFile, const std::string& fragmentShaderFile,
+                                          ShaderPreprocessor* preprocessor = nullptr, std::vector<std::string> defines = {});
+        void                        unwatch(Shader& shader);
+
+        /**
+            @description: Starts/stops the watcher thread. Files added by watch() later are picked up
+            when the thread is restarted.
+            @return void.
+        */
+        void                        start(void);
+        void                        stop(void);
+        bool                        isRunning(void) const noexcept;
+
+        /**
+            @description: Reads the sources of a watched program again, as if they had changed.
+            @param shader: the watched program.
+            @return void.
+        */
+        void                        requestReload(Shader& shader);
+
+        /**
+            @description: Starts builds for the changed sources and swaps in the programs whose build
+            has finished. It must be called at a frame boundary on the thread that owns the context.
+            @return void.
+        */
+        void                        update(void);
+
+        void                        setReloadCallback(ReloadCallback reloadCallback);
+        ui64                        getReloadCount(void) const noexcept;
+        ui64                        getFailedReloadCount(void) const noexcept;
+        //Returns how many builds were finished without parallel compile support, each may have blocked a frame.
+        ui64                        getBlockingBuildCount(void) const noexcept;
+    };
+
+    RS_INLINE bool ShaderHotReloader::isRunning(void) const noexcept
+    {
+        return mIsRunning;
+    }
+
+    RS_INLINE void ShaderHotReloader::setReloadCallback(ReloadCallback reloadCallback)
+    {
+        mReloadCallback = std::move(reloadCallback);
+    }
+
+    RS_INLINE ui64 ShaderHotReloader::getReloadCount(void) const noexcept
+    {
+        return mReloadCount;
+    }
+
+    RS_INLINE ui64 ShaderHotReloader::getFailedReloadCount(void) const noexcept
+    {
+        return mFailedReloadCount;
+    }
+
+    RS_INLINE ui64 ShaderHotReloader::getBlockingBuildCount(void) const noexcept
+    {
+        return mBlockingBuildCount;
+    }
+}
\ No newline at end of file
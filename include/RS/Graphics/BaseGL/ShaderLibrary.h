@@ -0,0 +1,159 @@
+/*
+BSD 2-Clause License
+Copyright (c) 2017, Davood Rasti and Alireza Rasti - rastisoft
+All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "RS/Common/CommonTypes.h"
+#include "RS/Graphics/BaseGL/ProgramBinaryCache.h"
+#include "RS/Graphics/BaseGL/Shader.h"
+
+namespace RS::Graphics::BaseGL
+{
+    struct ShaderBuildTiming
+    {
+        std::string                 name;
+        //CPU time of issuing the compiles and the link.(in millisec)
+        f32                         submitTime{0.0f};
+        //From the submission until the program was usable.(in millisec)
+        f32                         buildTime{0.0f};
+        bool                        isSucceeded{false};
+    };
+
+    /**
+        @description: Builds many programs at once. submit() issues the compiles and links of all the
+        added programs without querying their status, poll() finishes the ones the driver reports as
+        complete (GL_COMPLETION_STATUS_KHR) and returns at once, so an application can keep rendering a
+        loading screen while the driver compiles on its own threads. Without parallel compile support
+        poll() finishes programs until its time budget is used up, the frames stay responsive but each
+        program blocks while it is finished.
+    */
+    class ShaderLibrary
+    {
+    protected:
+        enum class BuildState : ui8
+        {
+            Added,
+            Submitted,
+            Succeeded,
+            Failed
+        };
+
+        struct ProgramEntry
+        {
+            std::string             name;
+            std::string             vertexShaderCode;
+            std::string             fragmentShaderCode;
+            Shader                  shader;
+            BuildState              state{BuildState::Added};
+            std::chrono::steady_clock::time_point submitStartTime;
+            ShaderBuildTiming       timing;
+            std::string             errorMessage;
+        };
+
+        //Entries are never moved, so the returned Shader references stay valid.
+        std::vector<std::unique_ptr<ProgramEntry>>  mPrograms;
+        std::unordered_map<std::string, ui32>       mProgramIndices;
+        ProgramBinaryCache*         mProgramBinaryCache;
+        ui32                        mFinishedCount{0};
+        ui32                        mFailedCount{0};
+
+        void                        finish(ProgramEntry& program);
+
+    public:
+        /**
+            @description: ShaderLibrary constructor.
+            @param programBinaryCache: the cache to restore/store the program binaries, nullptr for none.
+            @return
+        */
+                                    ShaderLibrary(ProgramBinaryCache* programBinaryCache = nullptr);
+                                    ShaderLibrary(const ShaderLibrary&) = delete;
+        ShaderLibrary&              operator=(const ShaderLibrary&) = delete;
+
+        /**
+            @description: Adds a program from files, the files are read at once.
+            @param name: the program name.
+            @param vertexShaderFile: the vertex shader file.
+            @param fragmentShaderFile: the fragment shader file.
+            @return Shader&: the program, usable once isReady(name) is true.
+        */
+        Shader&                     add(const std::string& name, const std::string& vertexShaderFile, const std::string& fragmentShaderFile);
+        Shader&                     addSource(const std::string& name, std::string vertexShaderCode, std::string fragmentShaderCode);
+
+        /**
+            @description: Issues the compiles and links of all the added programs.
+            @return void.
+        */
+        void                        submit(void);
+
+        /**
+            @description: Finishes the submitted programs that are complete. A program that fails is
+            reported by getErrorMessage(), the others go on.
+            @param timeBudget: stops finishing programs after this time.(in millisec, 0 for no limit)
+            @return bool: true if all the submitted programs are finished.
+        */
+        bool                        poll(f32 timeBudget = 0.0f);
+
+        /**
+            @description: Finishes all the submitted programs, blocking until the driver is done.
+            @return void.
+        */
+        void                        finishAll(void);
+
+        bool                        isReady(const std::string& name) const;
+        //nullptr if the program is unknown or not ready.
+        Shader*                     get(const std::string& name);
+        const std::string&          getErrorMessage(const std::string& name) const;
+
+        //The finished part of the programs, for a progress bar.
+        f32                         getProgress(void) const noexcept;
+        ui32                        getProgramCount(void) const noexcept;
+        ui32                        getFinishedCount(void) const noexcept;
+        ui32                        getFailedCount(void) const noexcept;
+        std::vector<ShaderBuildTiming> getTimings(void) const;
+    };
+
+    RS_INLINE f32 ShaderLibrary::getProgress(void) const noexcept
+    {
+        return mPrograms.empty() ? 1.0f : static_cast<f32>(mFinishedCount) / mPrograms.size();
+    }
+
+    RS_INLINE ui32 ShaderLibrary::getProgramCount(void) const noexcept
+    {
+        return static_cast<ui32>(mPrograms.size());
+    }
+
+    RS_INLINE ui32 ShaderLibrary::getFinishedCount(void) const noexcept
+    {
+        return mFinishedCount;
+    }
+
+    RS_INLINE ui32 ShaderLibrary::getFailedCount(void) const noexcept
+    {
+        return mFailedCount;
+    }
+}
\ No newline at end of file
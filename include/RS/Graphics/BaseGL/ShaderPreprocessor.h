@@ -0,0 +1,121 @@
+/*
+BSD 2-Clause License
+Copyright (c) 2017, Davood Rasti and Alireza Rasti - rastisoft
+All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "RS/Common/CommonTypes.h"
+
+namespace RS::Graphics::BaseGL
+{
+    /**
+        @description: Prepares shader files for glShaderSource. #include "file" lines are replaced by
+        the file, which is looked up next to the including file and then in the include directories.
+        A file is included once per source, later #include lines of it (and include cycles) are dropped, and #line
+        directives keep the line numbers of the compile errors right. #version lines of included files
+        are commented out. Defines are injected after #version. Both the files with their includes resolved and the sources with defines are cached
+        until clearCache(), or until invalidate() is called for one of the files they are built from.
+    */
+    class ShaderPreprocessor
+    {
+    protected:
+        struct LoadedFile
+        {
+            std::string                 source;
+            //The canonical paths of the file and of its includes.
+            std::vector<std::string>    files;
+        };
+
+        std::vector<std::string>    mIncludeDirectories;
+        //Files with their includes resolved, by path.
+        std::unordered_map<std::string, LoadedFile>     mLoadedFiles;
+        //Loaded files with defines injected, by path and defines.
+        std::unordered_map<std::string, std::string>    mExpandedSources;
+
+        std::string                 findIncludeFile(const std::string& include, const std::string& includingFile) const;
+        void                        expandIncludes(const std::string& file, std::unordered_set<std::string>* includedFiles,
+                                                   std::string* outSource) const;
+
+    public:
+                                    ShaderPreprocessor(void) = default;
+                                    ShaderPreprocessor(const ShaderPreprocessor&) = delete;
+        ShaderPreprocessor&         operator=(const ShaderPreprocessor&) = delete;
+
+        void                        addIncludeDirectory(const std::string& directory);
+
+        /**
+            @description: Reads a file and resolves its includes. It throws if a file cannot be found or read.
+            @param file: the shader file.
+            @return const std::string&: the source, valid until clearCache().
+        */
+        const std::string&          load(const std::string& file);
+
+        /**
+            @description: Returns the files a source is built from, i.e. the file and its includes.(see load())
+            @param file: the shader file.
+            @return const std::vector<std::string>&: canonical paths, valid until the source is invalidated.
+        */
+        const std::vector<std::string>& getFiles(const std::string& file);
+
+        /**
+            @description: Loads a file and injects the defines.(see load())
+            @param file: the shader file.
+            @param defines: "NAME" or "NAME VALUE" for each #define.
+            @return const std::string&: the source, valid until clearCache().
+        */
+        const std::string&          expand(const std::string& file, const std::vector<std::string>& defines);
+
+        /**
+            @description: Inserts a #define for each entry of defines after the #version line of source,
+            or at its beginning if it has none.
+            @param source: the shader source.
+            @param defines: "NAME" or "NAME VALUE" for each #define.
+            @return std::string.
+        */
+        static std::string          injectDefines(const std::string& source, const std::vector<std::string>& defines);
+
+        //Forgets the cached sources, e.g. after shader files have changed.
+        void                        clearCache(void);
+
+        /**
+            @description: Forgets the cached sources that are built from a changed file.
+            @param changedFile: the canonical path of the file.
+            @return void.
+        */
+        void                        invalidate(const std::string& changedFile);
+    };
+
+    RS_INLINE void ShaderPreprocessor::addIncludeDirectory(const std::string& directory)
+    {
+        mIncludeDirectories.push_back(directory);
+    }
+
+    RS_INLINE void ShaderPreprocessor::clearCache(void)
+    {
+        mLoadedFiles.clear();
+        mExpandedSources.clear();
+    }
+}
\ No newline at end of file
@@ -0,0 +1,134 @@
+/*
+BSD 2-Clause License
+Copyright (c) 2017, Davood Rasti and Alireza Rasti - rastisoft
+All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "RS/Common/CommonTypes.h"
+#include "RS/Graphics/BaseGL/ProgramBinaryCache.h"
+#include "RS/Graphics/BaseGL/Shader.h"
+#include "RS/Graphics/BaseGL/ShaderPreprocessor.h"
+
+namespace RS::Graphics::BaseGL
+{
+    /**
+        @description: The programs built from one pair of shader files with different sets of defines.
+        Bit i of a variant mask turns on the i-th define given to the constructor. A variant is
+        compiled on its first get(), or ahead of time by precompile(). Defines whose name does not
+        appear in the sources are not injected, and variants whose expanded sources are identical
+        (e.g. they only differ in such defines) share one program.
+    */
+    class ShaderVariant
+    {
+    protected:
+        struct ProgramEntry
+        {
+            std::string             vertexShaderCode;
+            std::string             fragmentShaderCode;
+            Shader                  shader;
+        };
+
+        ShaderPreprocessor&         mPreprocessor;
+        std::string                 mVertexShaderFile;
+        std::string                 mFragmentShaderFile;
+        std::vector<std::string>    mDefines;
+        ProgramBinaryCache*         mProgramBinaryCache;
+        //Entries are never moved, so the returned Shader references stay valid.
+        std::vector<std::unique_ptr<ProgramEntry>>  mPrograms;
+        //Programs by the hash of their expanded sources.
+        std::unordered_multimap<ui64, ProgramEntry*> mProgramsBySource;
+        std::unordered_map<ui64, ProgramEntry*>     mVariants;
+
+        /**
+            @description: Returns the program of a variant, adding it if its sources are new.
+            @param isAdded: set to whether the program has been added and must be built.
+            @return ProgramEntry&.
+        */
+        ProgramEntry&               findOrAddProgram(ui64 mask, bool* isAdded);
+
+    public:
+        /**
+            @description: ShaderVariant constructor.
+            @param preprocessor: resolves the includes and injects the defines, it must outlive the variants.
+            @param vertexShaderFile: the vertex shader file.
+            @param fragmentShaderFile: the fragment shader file.
+            @param defines: "NAME" or "NAME VALUE" for each bit of a variant mask, at most 64.
+            @param programBinaryCache: the cache to restore/store the program binaries, nullptr for none.
+            @return
+        */
+                                    ShaderVariant(ShaderPreprocessor& preprocessor, const std::string& vertexShaderFile,
+                                                  const std::string& fragmentShaderFile, std::vector<std::string> defines,
+                                                  ProgramBinaryCache* programBinaryCache = nullptr);
+                                    ShaderVariant(const ShaderVariant&) = delete;
+        ShaderVariant&              operator=(const ShaderVariant&) = delete;
+
+        /**
+            @description: Returns the program of a variant, compiling it if it is used for the first time.
+            @param mask: the defines of the variant.
+            @return Shader&.
+        */
+        Shader&                     get(ui64 mask);
+
+        /**
+            @description: Builds several variants at once, the compiles are all issued before any is
+            waited for, so a driver with parallel compile support can overlap them. If builds fail the
+            first error is thrown after all of them are finished.
+            @param masks: the variants.
+            @return void.
+        */
+        void                        precompile(const std::vector<ui64>& masks);
+
+        /**
+            @description: Precompiles the variants listed in a manifest file. Each line lists the define
+            names of one variant separated by spaces, "-" stands for the variant without defines and
+            lines starting with "#" are comments.
+            @param manifestFile: the manifest file.
+            @return void.
+        */
+        void                        precompileManifest(const std::string& manifestFile);
+
+        /**
+            @description: Returns the mask of a set of define names, it throws for unknown names.
+            @param names: the define names, without values.
+            @return ui64.
+        */
+        ui64                        getMask(const std::vector<std::string>& names) const;
+
+        //Variants that have been requested and the distinct programs built for them.
+        ui32                        getVariantCount(void) const noexcept;
+        ui32                        getProgramCount(void) const noexcept;
+    };
+
+    RS_INLINE ui32 ShaderVariant::getVariantCount(void) const noexcept
+    {
+        return static_cast<ui32>(mVariants.size());
+    }
+
+    RS_INLINE ui32 ShaderVariant::getProgramCount(void) const noexcept
+    {
+        return static_cast<ui32>(mPrograms.size());
+    }
+}
\ No newline at end of file
@@ -0,0 +1,150 @@
+/*
+BSD 2-Clause License
+Copyright (c) 2017, Davood Rasti and Alireza Rasti - rastisoft
+All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#pragma once
+
+#include <GL/glew.h>
+#include <vector>
+#include "RS/Common/CommonTypes.h"
+#include "RS/Graphics/BaseGL/GLStateCache.h"
+
+namespace RS::Graphics::BaseGL
+{
+    struct StreamAllocation
+    {
+        //Where the CPU writes the data.
+        void*                       pointer;
+        //The byte offset of the data in the buffer, to be used in draw calls/attribute pointers.
+        GLintptr                    offset;
+    };
+
+    /**
+        @description: Buffer for data that is rewritten every frame. With GL 4.4/ARB_buffer_storage the
+        store is mapped once (persistent and coherent) and split into regionCount per-frame regions;
+        a region is reused only after the fence placed at the end of its frame has signalled, so the
+        CPU never writes data the GPU is still reading. On GL 3.3 the store is orphaned at the start
+        of every frame and mapped unsynchronized instead.
+    */
+    class StreamBuffer
+    {
+    protected:
+        GLuint                      mBufferId{0};
+        GLenum                      mTarget;
+        ui32                        mRegionSize;
+        ui32                        mRegionCount;
+        ui32                        mRegionIndex{0};
+        //The offset of the next allocation in the current region.
+        ui32                        mRegionOffset{0};
+        std::vector<GLsync>         mRegionFences;
+        ui8*                        mMappedPointer{nullptr};
+        //The region offset that mMappedPointer points to.(only for orphaning)
+        ui32                        mMappedOffset{0};
+        bool                        mIsPersistent{false};
+        ui64                        mFenceWaitCount{0};
+
+        void                        waitForRegion(ui32 regionIndex);
+        void                        release(void);
+        //Maps and allocates through GL_COPY_WRITE_BUFFER, so an index stream does not
+        //change the element array buffer of the bound vertex array.
+        void                        bindForUpload(void);
+
+    public:
+        /**
+            @description: StreamBuffer constructor.
+            @param target: the buffer target.(e.g. GL_ARRAY_BUFFER)
+            @param regionSize: the maximum number of bytes written per frame.
+            @param regionCount: the number of frames that may be in flight.
+            @return
+        */
+                                    StreamBuffer(GLenum target, ui32 regionSize, ui32 regionCount = 3);
+                                    StreamBuffer(const StreamBuffer&) = delete;
+                                    StreamBuffer(StreamBuffer&& other) noexcept;
+        StreamBuffer&               operator=(const StreamBuffer&) = delete;
+        StreamBuffer&               operator=(StreamBuffer&& other) noexcept;
+        virtual                     ~StreamBuffer(void);
+
+        void                        bind(void);
+        void                        unbind(void);
+
+        /**
+            @description: Reserves size bytes in the region of the current frame.
+            @param size: the number of bytes.
+            @param alignment: the alignment of the returned offset.(a power of two)
+            @return StreamAllocation: the write pointer and the buffer offset of the data.
+        */
+        StreamAllocation            allocate(ui32 size, ui32 alignment = 4);
+
+        /**
+            @description: Makes the written data visible to GL. It must be called before the draw
+            calls that read the data. It is a no-op for persistent mapping.
+            @return void.
+        */
+        void                        flush(void);
+
+        /**
+            @description: Ends the frame: fences its region and moves to the next one. It should be
+            called once per frame after the last draw call that reads from the buffer.
+            @return void.
+        */
+        void                        endFrame(void);
+
+        GLuint                      getHandle(void) const noexcept;
+        bool                        isPersistent(void) const noexcept;
+
+        /**
+            @description: Returns how many times endFrame() found the next region still in use by the GPU.
+            @return ui64.
+        */
+        ui64                        getFenceWaitCount(void) const noexcept;
+    };
+
+    RS_INLINE void StreamBuffer::bindForUpload(void)
+    {
+        GLStateCache::getCurrent().bindBuffer(GL_COPY_WRITE_BUFFER, mBufferId);
+    }
+
+    RS_INLINE void StreamBuffer::bind(void)
+    {
+        GLStateCache::getCurrent().bindBuffer(mTarget, mBufferId);
+    }
+
+    RS_INLINE void StreamBuffer::unbind(void)
+    {
+        GLStateCache::getCurrent().bindBuffer(mTarget, 0);
+    }
+
+    RS_INLINE GLuint StreamBuffer::getHandle(void) const noexcept
+    {
+        return mBufferId;
+    }
+
+    RS_INLINE bool StreamBuffer::isPersistent(void) const noexcept
+    {
+        return mIsPersistent;
+    }
+
+    RS_INLINE ui64 StreamBuffer::getFenceWaitCount(void) const noexcept
+    {
+        return mFenceWaitCount;
+    }
+}
\ No newline at end of file
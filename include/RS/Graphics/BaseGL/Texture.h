@@ -26,22 +26,27 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <GL/glew.h>
 #include <string>
 #include "RS/Common/CommonTypes.h"
+#include "RS/Graphics/BaseGL/GLStateCache.h"
 
 namespace RS::Graphics::BaseGL
 {
     class Texture
     {
     protected:
-        ui8*        mImageData;
+        ui8*        mImageData{nullptr};
         GLenum      mFormat;
         GLuint      mTextureHandle;
         ui32        mWidth;
         ui32        mHeight;
         bool        mIsLoadedToGPU;
-        bool        mIsLoadedToMemory;
+        bool        mIsLoadedToMemory{false};
         
     public:
                     Texture(const std::string_view& textureFile = "");
+                    Texture(const Texture&) = delete;
+                    Texture(Texture&& other) noexcept;
+        Texture&    operator=(const Texture&) = delete;
+        Texture&    operator=(Texture&& other) noexcept;
         virtual     ~Texture(void);
 
         void        loadToMemory(const std::string_view& textureFile);
@@ -62,22 +67,19 @@ namespace RS::Graphics::BaseGL
     RS_INLINE void Texture::activeAndBind(ui16 textureUnit)
     {
         if(mTextureHandle > 0)
-        {
-            glActiveTexture(GL_TEXTURE0 + textureUnit);
-            glBindTexture(GL_TEXTURE_2D, mTextureHandle);
-        }
+            GLStateCache::getCurrent().bindTexture(textureUnit, GL_TEXTURE_2D, mTextureHandle);
     }
 
     RS_INLINE void Texture::bind(void)
     {
         if(mTextureHandle > 0)
-            glBindTexture(GL_TEXTURE_2D, mTextureHandle);
+            GLStateCache::getCurrent().bindTexture(GL_TEXTURE_2D, mTextureHandle);
     }
 
     RS_INLINE void Texture::unbind(void)
     {
         if(mTextureHandle > 0)
-            glBindTexture(GL_TEXTURE_2D, 0);        
+            GLStateCache::getCurrent().bindTexture(GL_TEXTURE_2D, 0);
     }
 
     RS_INLINE ui32 Texture::getWidth(void)
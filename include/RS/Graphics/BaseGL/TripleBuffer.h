@@ -0,0 +1,137 @@
+/*
+BSD 2-Clause License
+Copyright (c) 2017, Davood Rasti and Alireza Rasti - rastisoft
+All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include "RS/Common/CommonTypes.h"
+
+namespace RS::Graphics::BaseGL
+{
+    /**
+        @description: Lock-free index exchange of a triple buffer with one writer and one reader
+        thread. The writer always owns one slot, the reader another and the third one holds the
+        latest completed slot; publish() and acquire() swap the owned slot with it.
+    */
+    class TripleBufferIndex
+    {
+    protected:
+        static constexpr ui8        indexMask{0x3};
+        static constexpr ui8        newDataBit{0x4};
+
+        std::atomic<ui8>            mSharedIndex{1};
+        ui8                         mWriteIndex{0};
+        ui8                         mReadIndex{2};
+
+    public:
+        /**
+            @description: Returns the slot that the writer thread may write to.
+            @return ui32.
+        */
+        ui32                        getWriteIndex(void) const noexcept;
+
+        /**
+            @description: Makes the written slot the latest completed one. It is called by the writer thread.
+            @return void.
+        */
+        void                        publish(void) noexcept;
+
+        /**
+            @description: Takes the latest completed slot if one was published since the last call.
+            It is called by the reader thread.
+            @return bool: true if the read slot has changed.
+        */
+        bool                        acquire(void) noexcept;
+
+        /**
+            @description: Returns the slot that the reader thread may read from.
+            @return ui32.
+        */
+        ui32                        getReadIndex(void) const noexcept;
+    };
+
+    //Three instances of T exchanged by a TripleBufferIndex.
+    template <class T>
+    class TripleBuffer
+    {
+    protected:
+        std::array<T, 3>            mSlots;
+        TripleBufferIndex           mIndex;
+
+    public:
+        T&                          getWriteSlot(void) noexcept;
+        void                        publish(void) noexcept;
+
+        bool                        acquire(void) noexcept;
+        const T&                    getReadSlot(void) const noexcept;
+    };
+
+    RS_INLINE ui32 TripleBufferIndex::getWriteIndex(void) const noexcept
+    {
+        return mWriteIndex;
+    }
+
+    RS_INLINE void TripleBufferIndex::publish(void) noexcept
+    {
+        mWriteIndex = mSharedIndex.exchange(mWriteIndex | newDataBit, std::memory_order_acq_rel) & indexMask;
+    }
+
+    RS_INLINE bool TripleBufferIndex::acquire(void) noexcept
+    {
+        if((mSharedIndex.load(std::memory_order_relaxed) & newDataBit) == 0)
+            return false;
+
+        mReadIndex = mSharedIndex.exchange(mReadIndex, std::memory_order_acq_rel) & indexMask;
+        return true;
+    }
+
+    RS_INLINE ui32 TripleBufferIndex::getReadIndex(void) const noexcept
+    {
+        return mReadIndex;
+    }
+
+    template <typename T>
+    RS_INLINE T& TripleBuffer<T>::getWriteSlot(void) noexcept
+    {
+        return mSlots[mIndex.getWriteIndex()];
+    }
+
+    template <typename T>
+    RS_INLINE void TripleBuffer<T>::publish(void) noexcept
+    {
+        mIndex.publish();
+    }
+
+    template <typename T>
+    RS_INLINE bool TripleBuffer<T>::acquire(void) noexcept
+    {
+        return mIndex.acquire();
+    }
+
+    template <typename T>
+    RS_INLINE const T& TripleBuffer<T>::getReadSlot(void) const noexcept
+    {
+        return mSlots[mIndex.getReadIndex()];
+    }
+}
\ No newline at end of file
@@ -0,0 +1,227 @@
+/*
+BSD 2-Clause License
+Copyright (c) 2017, Davood Rasti and Alireza Rasti - rastisoft
+All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#pragma once
+
+#include <GL/glew.h>
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+#include "RS/Common/CommonTypes.h"
+#include "RS/Graphics/BaseGL/Buffer.h"
+#include "RS/Graphics/BaseGL/GLStateCache.h"
+#include "RS/Graphics/BaseGL/Shader.h"
+
+namespace RS::Graphics::BaseGL
+{
+    //GLSL types of std140 block members.
+    enum class Std140Type
+    {
+        Float,
+        Int,
+        UInt,
+        //GLSL bool, 4 bytes.(use i32/ui32)
+        Bool,
+        Vec2,
+        Vec3,
+        Vec4,
+        IVec4,
+        //Three vec4 columns, 48 bytes.
+        Mat3,
+        Mat4
+    };
+
+    //Base alignment and size of a std140 member in bytes.
+    template <Std140Type Type> struct Std140Traits;
+    template <> struct Std140Traits<Std140Type::Float> { static constexpr ui32 alignment{4};  static constexpr ui32 size{4}; };
+    template <> struct Std140Traits<Std140Type::Int>   { static constexpr ui32 alignment{4};  static constexpr ui32 size{4}; };
+    template <> struct Std140Traits<Std140Type::UInt>  { static constexpr ui32 alignment{4};  static constexpr ui32 size{4}; };
+    template <> struct Std140Traits<Std140Type::Bool>  { static constexpr ui32 alignment{4};  static constexpr ui32 size{4}; };
+    template <> struct Std140Traits<Std140Type::Vec2>  { static constexpr ui32 alignment{8};  static constexpr ui32 size{8}; };
+    template <> struct Std140Traits<Std140Type::Vec3>  { static constexpr ui32 alignment{16}; static constexpr ui32 size{12}; };
+    template <> struct Std140Traits<Std140Type::Vec4>  { static constexpr ui32 alignment{16}; static constexpr ui32 size{16}; };
+    template <> struct Std140Traits<Std140Type::IVec4> { static constexpr ui32 alignment{16}; static constexpr ui32 size{16}; };
+    template <> struct Std140Traits<Std140Type::Mat3>  { static constexpr ui32 alignment{16}; static constexpr ui32 size{48}; };
+    template <> struct Std140Traits<Std140Type::Mat4>  { static constexpr ui32 alignment{16}; static constexpr ui32 size{64}; };
+
+    //In std140 every array element starts on a vec4 boundary.
+    template <Std140Type Type, ui32 Count>
+    struct Std140ArrayTraits
+    {
+        static constexpr ui32       stride{(Std140Traits<Type>::size + 15) & ~15u};
+        static constexpr ui32       alignment{16};
+        static constexpr ui32       size{stride * Count};
+    };
+
+    /**
+        @description: Checks at compile time that a member of a C++ struct is where the std140 layout
+        puts the GLSL member of type Type, e.g. RS_STD140_MEMBER(CameraData, viewProjection, Mat4).
+        The members must be checked in declaration order, a member that is placed tighter than std140
+        allows (e.g. a vec3 right after another vec3) fails the alignment check.
+    */
+    #define RS_STD140_MEMBER(Struct, member, Type) \
+        static_assert(offsetof(Struct, member) % RS::Graphics::BaseGL::Std140Traits<RS::Graphics::BaseGL::Std140Type::Type>::alignment == 0, \
+                      #Struct "::" #member " is not aligned as a std140 " #Type "."); \
+        static_assert(sizeof(Struct::member) == RS::Graphics::BaseGL::Std140Traits<RS::Graphics::BaseGL::Std140Type::Type>::size, \
+                      #Struct "::" #member " does not have the size of a std140 " #Type ".")
+
+    //The array form of RS_STD140_MEMBER, e.g. RS_STD140_ARRAY(LightData, positions, Vec4, 8).
+    #define RS_STD140_ARRAY(Struct, member, Type, Count) \
+        static_assert(offsetof(Struct, member) % RS::Graphics::BaseGL::Std140ArrayTraits<RS::Graphics::BaseGL::Std140Type::Type, Count>::alignment == 0, \
+                      #Struct "::" #member " is not aligned as a std140 " #Type " array."); \
+        static_assert(sizeof(Struct::member) == RS::Graphics::BaseGL::Std140ArrayTraits<RS::Graphics::BaseGL::Std140Type::Type, Count>::size, \
+                      #Struct "::" #member " does not have the size of a std140 " #Type "[" #Count "], elements must be padded to vec4.")
+
+    /**
+        @description: Mirrors a std140 uniform block in the C++ struct T and keeps it in a uniform
+        buffer. The members of T are checked with RS_STD140_MEMBER/RS_STD140_ARRAY next to its
+        declaration. Data shared by several programs (camera, lights, ...) is written once per frame
+        with upload() and every program reads it from the binding point.
+    */
+    template <class T>
+    class UniformBlock
+    {
+        static_assert(std::is_standard_layout_v<T> && std::is_trivially_copyable_v<T>,
+                      "UniformBlock: T must be a plain struct.");
+        static_assert(sizeof(T) % 16 == 0, "UniformBlock: std140 rounds the block size up to a multiple of vec4, pad T.");
+
+    private:
+        Buffer<T>   mBuffer;
+        T           mData{};
+        ui32        mBindingPoint;
+        bool        mIsDirty{true};
+
+    public:
+        /**
+            @description: UniformBlock constructor.
+            @param bindingPoint: the binding point of GL_UNIFORM_BUFFER the block is bound to.
+            @return
+        */
+                    UniformBlock(ui32 bindingPoint);
+                    UniformBlock(UniformBlock&&) noexcept = default;
+        UniformBlock& operator=(UniformBlock&&) noexcept = default;
+
+        /**
+            @description: Returns the CPU copy of the block for writing, upload() sends it.
+            @return T&.
+        */
+        T&          edit(void) noexcept;
+        const T&    get(void) const noexcept;
+        void        set(const T& data);
+
+        /**
+            @description: Writes the block to the buffer in one call if it has changed since the last upload.
+            @return void.
+        */
+        void        upload(void);
+
+        /**
+            @description: Binds the buffer to the binding point with glBindBufferBase.
+            @return void.
+        */
+        void        bind(void);
+
+        /**
+            @description: Binds the uniform block blockName of a program to the binding point of this block.
+            In debug builds it asserts that the block of the program is not larger than T.
+            @param shader: the program.
+            @param blockName: the name of the block in the program.
+            @return bool: false if the program has no such block.
+        */
+        bool        attach(Shader& shader, const std::string& blockName);
+
+        ui32        getBindingPoint(void) const noexcept;
+        GLuint      getHandle(void) const noexcept;
+    };
+
+    template <class T>
+    UniformBlock<T>::UniformBlock(ui32 bindingPoint) :
+        mBuffer(GL_UNIFORM_BUFFER, BufferUsage::Dynamic)
+        ,mBindingPoint(bindingPoint)
+    {
+        mBuffer.set(nullptr, sizeof(T));
+    }
+
+    template <class T>
+    RS_INLINE T& UniformBlock<T>::edit(void) noexcept
+    {
+        mIsDirty = true;
+        return mData;
+    }
+
+    template <class T>
+    RS_INLINE const T& UniformBlock<T>::get(void) const noexcept
+    {
+        return mData;
+    }
+
+    template <class T>
+    RS_INLINE void UniformBlock<T>::set(const T& data)
+    {
+        mData = data;
+        mIsDirty = true;
+    }
+
+    template <class T>
+    RS_INLINE void UniformBlock<T>::upload(void)
+    {
+        if(!mIsDirty)
+            return;
+
+        //Orphaning keeps draws of the previous frame from stalling the write.
+        mBuffer.stream(&mData, sizeof(T));
+        mIsDirty = false;
+    }
+
+    template <class T>
+    RS_INLINE void UniformBlock<T>::bind(void)
+    {
+        glBindBufferBase(GL_UNIFORM_BUFFER, mBindingPoint, mBuffer.getHandle());
+        //glBindBufferBase also binds the generic GL_UNIFORM_BUFFER target.
+        GLStateCache::getCurrent().onBufferBound(GL_UNIFORM_BUFFER, mBuffer.getHandle());
+    }
+
+    template <class T>
+    bool UniformBlock<T>::attach(Shader& shader, const std::string& blockName)
+    {
+        if(!shader.bindUniformBlock(blockName, mBindingPoint))
+            return false;
+
+        assert(static_cast<ui32>(shader.findUniformBlock(blockName)->dataSize) <= sizeof(T) &&
+               "UniformBlock: the block of the program is larger than T.");
+
+        return true;
+    }
+
+    template <class T>
+    RS_INLINE ui32 UniformBlock<T>::getBindingPoint(void) const noexcept
+    {
+        return mBindingPoint;
+    }
+
+    template <class T>
+    RS_INLINE GLuint UniformBlock<T>::getHandle(void) const noexcept
+    {
+        return mBuffer.getHandle();
+    }
+}
\ No newline at end of file
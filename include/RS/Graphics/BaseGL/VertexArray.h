@@ -0,0 +1,157 @@
+/*
+BSD 2-Clause License
+Copyright (c) 2017, Davood Rasti and Alireza Rasti - rastisoft
+All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#pragma once
+
+#include <GL/glew.h>
+#include "RS/Common/CommonTypes.h"
+#include "RS/Graphics/BaseGL/Buffer.h"
+#include "RS/Graphics/BaseGL/DeletionQueue.h"
+#include "RS/Graphics/BaseGL/GLStateCache.h"
+#include "RS/Graphics/BaseGL/VertexLayout.h"
+
+namespace RS::Graphics::BaseGL
+{
+    /**
+        @description: A vertex array object that stores the attribute setup of its vertex buffers and
+        its index buffer. It is built once, after that a draw only needs bind(). Per-instance data is
+        attached like vertex data, with a layout of InstanceAttributes.
+    */
+    class VertexArray
+    {
+    protected:
+        GLuint      mVertexArrayId{0};
+        GLenum      mIndexType{0};
+
+    public:
+                    VertexArray(void);
+                    VertexArray(const VertexArray&) = delete;
+                    VertexArray(VertexArray&& other) noexcept;
+        VertexArray& operator=(const VertexArray&) = delete;
+        VertexArray& operator=(VertexArray&& other) noexcept;
+        virtual     ~VertexArray(void);
+
+        void        bind(void);
+        void        unbind(void);
+
+        /**
+            @description: Attaches a vertex buffer whose vertices have the format TLayout.
+            @param buffer: the vertex buffer.
+            @param baseOffset: the byte offset of the first vertex in the buffer.
+            @return void.
+        */
+        template <class TLayout, class T>
+        void        addVertexBuffer(Buffer<T>& buffer, GLintptr baseOffset = 0);
+
+        /**
+            @description: Attaches a vertex buffer by name, e.g. a StreamBuffer or a BufferArena.
+            Attaching the same layout again with another offset moves its attributes.
+            @param buffer: the buffer name.
+            @param baseOffset: the byte offset of the first vertex in the buffer.
+            @return void.
+        */
+        template <class TLayout>
+        void        addVertexBuffer(GLuint buffer, GLintptr baseOffset = 0);
+
+        /**
+            @description: Attaches the index buffer, the index type is derived from T.
+            @param buffer: the index buffer.
+            @return void.
+        */
+        template <class T>
+        void        setIndexBuffer(Buffer<T>& buffer);
+
+        /**
+            @description: Binds the vertex array and draws instanceCount instances of vertexCount vertices.
+            @param mode: the primitive type.(e.g. GL_TRIANGLES)
+            @param firstVertex: the first vertex.
+            @param vertexCount: the number of vertices per instance.
+            @param instanceCount: the number of instances.
+            @return void.
+        */
+        void        drawInstanced(GLenum mode, i32 firstVertex, i32 vertexCount, i32 instanceCount);
+
+        /**
+            @description: Binds the vertex array and draws instanceCount instances of the indexed geometry.
+            @param mode: the primitive type.(e.g. GL_TRIANGLES)
+            @param indexCount: the number of indices per instance.
+            @param instanceCount: the number of instances.
+            @param firstIndex: the first index in the index buffer.
+            @param baseVertex: added to every index.
+            @return void.
+        */
+        void        drawElementsInstanced(GLenum mode, i32 indexCount, i32 instanceCount, ui32 firstIndex = 0, i32 baseVertex = 0);
+
+        GLuint      getHandle(void) const noexcept;
+        //GL_UNSIGNED_BYTE/SHORT/INT, or 0 if there is no index buffer.
+        GLenum      getIndexType(void) const noexcept;
+    };
+
+    RS_INLINE void VertexArray::bind(void)
+    {
+        GLStateCache::getCurrent().bindVertexArray(mVertexArrayId);
+    }
+
+    RS_INLINE void VertexArray::unbind(void)
+    {
+        GLStateCache::getCurrent().bindVertexArray(0);
+    }
+
+    template <class TLayout, class T>
+    void VertexArray::addVertexBuffer(Buffer<T>& buffer, GLintptr baseOffset)
+    {
+        addVertexBuffer<TLayout>(buffer.getHandle(), baseOffset);
+    }
+
+    template <class TLayout>
+    void VertexArray::addVertexBuffer(GLuint buffer, GLintptr baseOffset)
+    {
+        bind();
+        GLStateCache::getCurrent().bindBuffer(GL_ARRAY_BUFFER, buffer);
+        TLayout::apply(baseOffset);
+    }
+
+    template <class T>
+    void VertexArray::setIndexBuffer(Buffer<T>& buffer)
+    {
+        bind();
+        GLStateCache::getCurrent().bindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffer.getHandle());
+        mIndexType = GLTypeTraits<T>::type;
+    }
+
+    RS_INLINE void VertexArray::drawInstanced(GLenum mode, i32 firstVertex, i32 vertexCount, i32 instanceCount)
+    {
+        bind();
+        glDrawArraysInstanced(mode, firstVertex, vertexCount, instanceCount);
+    }
+
+    RS_INLINE GLuint VertexArray::getHandle(void) const noexcept
+    {
+        return mVertexArrayId;
+    }
+
+    RS_INLINE GLenum VertexArray::getIndexType(void) const noexcept
+    {
+        return mIndexType;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,126 @@
+/*
+BSD 2-Clause License
+Copyright (c) 2017, Davood Rasti and Alireza Rasti - rastisoft
+All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#pragma once
+
+#include <GL/glew.h>
+#include <cstddef>
+#include <unordered_map>
+#include "RS/Common/CommonTypes.h"
+#include "RS/Graphics/BaseGL/Buffer.h"
+#include "RS/Graphics/BaseGL/VertexArray.h"
+
+namespace RS::Graphics::BaseGL
+{
+    /**
+        @description: Keeps one vertex array per (layout, vertex buffer, base offset, index buffer), so
+        geometry that is drawn with the same buffers is set up once and every later draw only binds
+        its vertex array. A buffer must be removed with remove() before it is deleted, since its name
+        may be reused by a new buffer.
+    */
+    class VertexArrayCache
+    {
+    protected:
+        struct Key
+        {
+            const void*     layout;
+            GLuint          vertexBuffer;
+            GLintptr        baseOffset;
+            GLuint          indexBuffer;
+
+            bool            operator==(const Key& other) const noexcept;
+        };
+
+        struct KeyHash
+        {
+            std::size_t     operator()(const Key& key) const noexcept;
+        };
+
+        std::unordered_map<Key, VertexArray, KeyHash> mVertexArrays;
+
+    public:
+                            VertexArrayCache(void) = default;
+                            VertexArrayCache(const VertexArrayCache&) = delete;
+        VertexArrayCache&   operator=(const VertexArrayCache&) = delete;
+
+        /**
+            @description: Returns the vertex array of the vertex buffer with the format TLayout and
+            the index buffer, it is created on the first call.
+            @param vertexBuffer: the vertex buffer.
+            @param indexBuffer: the index buffer.
+            @param baseOffset: the byte offset of the first vertex in the vertex buffer.
+            @return VertexArray&.
+        */
+        template <class TLayout, class T, class TIndex>
+        VertexArray&        get(Buffer<T>& vertexBuffer, Buffer<TIndex>& indexBuffer, GLintptr baseOffset = 0);
+        template <class TLayout, class T>
+        VertexArray&        get(Buffer<T>& vertexBuffer, GLintptr baseOffset = 0);
+
+        /**
+            @description: Drops the vertex arrays that use buffer as vertex or index buffer.
+            @param buffer: the buffer name.
+            @return void.
+        */
+        void                remove(GLuint buffer);
+        void                clear(void);
+        std::size_t         getSize(void) const noexcept;
+    };
+
+    template <class TLayout, class T, class TIndex>
+    VertexArray& VertexArrayCache::get(Buffer<T>& vertexBuffer, Buffer<TIndex>& indexBuffer, GLintptr baseOffset)
+    {
+        const Key key{TLayout::getId(), vertexBuffer.getHandle(), baseOffset, indexBuffer.getHandle()};
+        auto vertexArray = mVertexArrays.find(key);
+        if(vertexArray != mVertexArrays.end())
+            return vertexArray->second;
+
+        auto& newVertexArray = mVertexArrays[key];
+        newVertexArray.addVertexBuffer<TLayout>(vertexBuffer, baseOffset);
+        newVertexArray.setIndexBuffer(indexBuffer);
+        return newVertexArray;
+    }
+
+    template <class TLayout, class T>
+    VertexArray& VertexArrayCache::get(Buffer<T>& vertexBuffer, GLintptr baseOffset)
+    {
+        const Key key{TLayout::getId(), vertexBuffer.getHandle(), baseOffset, 0};
+        auto vertexArray = mVertexArrays.find(key);
+        if(vertexArray != mVertexArrays.end())
+            return vertexArray->second;
+
+        auto& newVertexArray = mVertexArrays[key];
+        newVertexArray.addVertexBuffer<TLayout>(vertexBuffer, baseOffset);
+        return newVertexArray;
+    }
+
+    RS_INLINE bool VertexArrayCache::Key::operator==(const Key& other) const noexcept
+    {
+        return layout == other.layout && vertexBuffer == other.vertexBuffer &&
+               baseOffset == other.baseOffset && indexBuffer == other.indexBuffer;
+    }
+
+    RS_INLINE std::size_t VertexArrayCache::getSize(void) const noexcept
+    {
+        return mVertexArrays.size();
+    }
+}
\ No newline at end of file
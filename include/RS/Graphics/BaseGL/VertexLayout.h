@@ -0,0 +1,154 @@
+/*
+BSD 2-Clause License
+Copyright (c) 2017, Davood Rasti and Alireza Rasti - rastisoft
+All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#pragma once
+
+#include <GL/glew.h>
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include "RS/Common/CommonTypes.h"
+
+namespace RS::Graphics::BaseGL
+{
+    //Maps a C++ type to its GL type enum.
+    template <typename T> struct GLTypeTraits;
+    template <> struct GLTypeTraits<f32>  { static constexpr GLenum type = GL_FLOAT; };
+    template <> struct GLTypeTraits<i8>   { static constexpr GLenum type = GL_BYTE; };
+    template <> struct GLTypeTraits<ui8>  { static constexpr GLenum type = GL_UNSIGNED_BYTE; };
+    template <> struct GLTypeTraits<i16>  { static constexpr GLenum type = GL_SHORT; };
+    template <> struct GLTypeTraits<ui16> { static constexpr GLenum type = GL_UNSIGNED_SHORT; };
+    template <> struct GLTypeTraits<i32>  { static constexpr GLenum type = GL_INT; };
+    template <> struct GLTypeTraits<ui32> { static constexpr GLenum type = GL_UNSIGNED_INT; };
+
+    /**
+        @description: Describes one vertex attribute.
+        @param Location: the attribute location in the shader.(layout(location = ...))
+        @param T: the component type.
+        @param Components: the number of components, 1 to 4.
+        @param Normalized: whether integer components are normalized to [0, 1]/[-1, 1].
+        @param Divisor: 0 for per-vertex data, otherwise the attribute advances once every Divisor instances.
+    */
+    template <ui32 Location, typename T, ui32 Components, bool Normalized = false, ui32 Divisor = 0>
+    struct VertexAttribute
+    {
+        static_assert(Components >= 1 && Components <= 4, "A vertex attribute has 1 to 4 components.");
+
+        static constexpr ui32       location{Location};
+        static constexpr GLenum     type{GLTypeTraits<T>::type};
+        static constexpr ui32       components{Components};
+        static constexpr GLboolean  normalized{Normalized ? GL_TRUE : GL_FALSE};
+        static constexpr ui32       size{sizeof(T) * Components};
+        static constexpr ui32       divisor{Divisor};
+    };
+
+    //An attribute that advances once per instance.
+    template <ui32 Location, typename T, ui32 Components, bool Normalized = false>
+    using InstanceAttribute = VertexAttribute<Location, T, Components, Normalized, 1>;
+
+    /**
+        @description: Vertex format of TVertex whose members are the attributes in declaration order.
+        The stride and the offsets are derived at compile time; the attribute sizes must add up to
+        sizeof(TVertex), so a struct with padding or a mismatching attribute list does not compile.
+    */
+    template <typename TVertex, typename... TAttributes>
+    class VertexLayout
+    {
+    public:
+        typedef TVertex             VertexType;
+
+        static constexpr ui32       attributeCount{sizeof...(TAttributes)};
+        static constexpr ui32       stride{sizeof(TVertex)};
+
+    private:
+        static constexpr std::array<ui32, attributeCount> computeOffsets(void)
+        {
+            constexpr std::array<ui32, attributeCount> sizes{TAttributes::size...};
+            std::array<ui32, attributeCount> offsets{};
+
+            ui32 offset{0};
+            for(ui32 index = 0; index < attributeCount; ++index)
+            {
+                offsets[index] = offset;
+                offset += sizes[index];
+            }
+
+            return offsets;
+        }
+
+        template <std::size_t... Indices>
+        static void apply(GLintptr baseOffset, std::index_sequence<Indices...>)
+        {
+            (applyAttribute<TAttributes>(baseOffset + offsets[Indices]), ...);
+        }
+
+        template <typename TAttribute>
+        static void applyAttribute(GLintptr offset)
+        {
+            glEnableVertexAttribArray(TAttribute::location);
+            glVertexAttribPointer(TAttribute::location, TAttribute::components, TAttribute::type,
+                                  TAttribute::normalized, stride, reinterpret_cast<const void*>(offset));
+            if constexpr(TAttribute::divisor != 0)
+                glVertexAttribDivisor(TAttribute::location, TAttribute::divisor);
+        }
+
+    public:
+        static constexpr std::array<ui32, attributeCount> offsets{computeOffsets()};
+        static constexpr std::array<ui32, attributeCount> sizes{TAttributes::size...};
+
+        static_assert(attributeCount > 0, "A vertex layout needs at least one attribute.");
+        static_assert((TAttributes::size + ... + 0) == sizeof(TVertex),
+                      "The attribute sizes do not match the vertex struct.(missing attribute or padding)");
+        static_assert(std::is_trivially_copyable_v<TVertex>, "Vertices must be trivially copyable.");
+
+        /**
+            @description: Sets up the attribute pointers for the buffer bound to GL_ARRAY_BUFFER
+            in the bound vertex array.
+            @param baseOffset: the byte offset of the first vertex in the buffer.
+            @return void.
+        */
+        static void                 apply(GLintptr baseOffset = 0)
+        {
+            apply(baseOffset, std::make_index_sequence<attributeCount>());
+        }
+
+        //Identifies the layout, e.g. as a cache key. (see VertexArrayCache)
+        static const void*          getId(void)
+        {
+            static const char id{0};
+            return &id;
+        }
+    };
+
+    /**
+        @description: Checks at compile time that the attribute at Index of Layout matches member of
+        the vertex struct in offset and size, e.g. RS_VERTEX_ATTRIBUTE(SimpleVertexLayout, 1, uv).
+        It catches members that were reordered without reordering the attributes.
+    */
+    #define RS_VERTEX_ATTRIBUTE(Layout, Index, member) \
+        static_assert(offsetof(Layout::VertexType, member) == Layout::offsets[Index], \
+                      #Layout " attribute " #Index " is not at the offset of " #member "."); \
+        static_assert(sizeof(Layout::VertexType::member) == Layout::sizes[Index], \
+                      #Layout " attribute " #Index " does not have the size of " #member ".")
+}
\ No newline at end of file
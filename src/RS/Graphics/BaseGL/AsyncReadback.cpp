@@ -0,0 +1,287 @@
+/*
+BSD 2-Clause License
+Copyright (c) 2017, Davood Rasti and Alireza Rasti - rastisoft
+All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "RS/Graphics/BaseGL/AsyncReadback.h"
+#include "RS/Exception/RSException.h"
+#include "RS/Graphics/BaseGL/DeletionQueue.h"
+#include "RS/Graphics/BaseGL/GLStateCache.h"
+
+#include <cassert>
+#include <memory>
+
+using namespace RS::Exception;
+
+namespace RS::Graphics::BaseGL
+{
+    namespace
+    {
+        std::pair<AsyncReadback::Callback, std::future<std::vector<ui8>>> makePromiseCallback(void)
+        {
+            auto promise = std::make_shared<std::promise<std::vector<ui8>>>();
+            auto future = promise->get_future();
+
+            AsyncReadback::Callback callback = [promise](const ui8* data, ui32 size)
+            {
+                promise->set_value(std::vector<ui8>(data, data + size));
+            };
+
+            return {std::move(callback), std::move(future)};
+        }
+    }
+
+    AsyncReadback::AsyncReadback(ui32 slotCount) :
+        mSlots(slotCount)
+    {
+        assert(slotCount > 0);
+    }
+
+    AsyncReadback::~AsyncReadback(void)
+    {
+        releaseBuffers();
+    }
+
+    void AsyncReadback::releaseBuffers(void)
+    {
+        for(auto& slot : mSlots)
+        {
+            if(slot.fence)
+                glDeleteSync(slot.fence);
+
+            DeletionQueue::getCurrent().release(GLObjectType::Buffer, slot.buffer);
+            slot = ReadbackSlot();
+        }
+
+        mHeadIndex = 0;
+        mPendingCount = 0;
+    }
+
+    ui32 AsyncReadback::getPixelSize(GLenum format, GLenum type)
+    {
+        //Packed types hold the whole pixel.
+        switch(type)
+        {
+            case GL_UNSIGNED_BYTE_3_3_2: case GL_UNSIGNED_BYTE_2_3_3_REV:
+                return 1;
+            case GL_UNSIGNED_SHORT_5_6_5: case GL_UNSIGNED_SHORT_5_6_5_REV:
+            case GL_UNSIGNED_SHORT_4_4_4_4: case GL_UNSIGNED_SHORT_4_4_4_4_REV:
+            case GL_UNSIGNED_SHORT_5_5_5_1: case GL_UNSIGNED_SHORT_1_5_5_5_REV:
+                return 2;
+            case GL_UNSIGNED_INT_8_8_8_8: case GL_UNSIGNED_INT_8_8_8_8_REV:
+            case GL_UNSIGNED_INT_10_10_10_2: case GL_UNSIGNED_INT_2_10_10_10_REV:
+            case GL_UNSIGNED_INT_24_8: case GL_UNSIGNED_INT_10F_11F_11F_REV: case GL_UNSIGNED_INT_5_9_9_9_REV:
+                return 4;
+            case GL_FLOAT_32_UNSIGNED_INT_24_8_REV:
+                //A 32-bit float depth followed by 24 unused bits and the 8-bit stencil.
+                return 8;
+            default:
+                break;
+        }
+
+        ui32 componentCount{0};
+        switch(format)
+        {
+            case GL_RED: case GL_GREEN: case GL_BLUE:
+            case GL_RED_INTEGER: case GL_GREEN_INTEGER: case GL_BLUE_INTEGER:
+            case GL_DEPTH_COMPONENT: case GL_STENCIL_INDEX:
+                componentCount = 1;
+                break;
+            case GL_RG: case GL_RG_INTEGER:
+                componentCount = 2;
+                break;
+            case GL_RGB: case GL_BGR: case GL_RGB_INTEGER: case GL_BGR_INTEGER:
+                componentCount = 3;
+                break;
+            case GL_RGBA: case GL_BGRA: case GL_RGBA_INTEGER: case GL_BGRA_INTEGER:
+                componentCount = 4;
+                break;
+            default:
+                //GL_DEPTH_STENCIL is only read with the packed types above.
+                assert(0 && "AsyncReadback: unsupported pixel format/type.");
+                return 0;
+        }
+
+        switch(type)
+        {
+            case GL_UNSIGNED_BYTE: case GL_BYTE:
+                return componentCount;
+            case GL_UNSIGNED_SHORT: case GL_SHORT: case GL_HALF_FLOAT:
+                return componentCount * 2;
+            case GL_UNSIGNED_INT: case GL_INT: case GL_FLOAT:
+                return componentCount * 4;
+            default:
+                assert(0 && "AsyncReadback: unsupported pixel type.");
+                return 0;
+        }
+    }
+
+    AsyncReadback::ReadbackSlot& AsyncReadback::acquireSlot(ui32 size)
+    {
+        //The slot of a running callback is still mapped.
+        assert(!mIsPolling && "AsyncReadback callbacks must not make new requests.");
+
+        poll();
+
+        if(mPendingCount == mSlots.size())
+        {
+            //All slots are in flight, the oldest one has to be waited for.
+            auto& oldestSlot = mSlots[mHeadIndex];
+            glClientWaitSync(oldestSlot.fence, GL_SYNC_FLUSH_COMMANDS_BIT, GL_TIMEOUT_IGNORED);
+            ++mStallCount;
+            poll();
+        }
+
+        auto& slot = mSlots[(mHeadIndex + mPendingCount) % mSlots.size()];
+        auto& stateCache = GLStateCache::getCurrent();
+
+        if(slot.buffer == 0)
+            glGenBuffers(1, &slot.buffer);
+
+        stateCache.bindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+        if(size > slot.capacity)
+        {
+            glBufferData(GL_PIXEL_PACK_BUFFER, size, nullptr, GL_STREAM_READ);
+            slot.capacity = size;
+        }
+
+        slot.size = size;
+        return slot;
+    }
+
+    void AsyncReadback::readPixels(i32 x, i32 y, i32 width, i32 height, GLenum format, GLenum type, Callback callback)
+    {
+        assert(width > 0 && height > 0);
+
+        const ui32 size = static_cast<ui32>(width) * static_cast<ui32>(height) * getPixelSize(format, type);
+        auto& slot = acquireSlot(size);
+
+        //Rows are packed tightly to match size, the caller's alignment is restored afterwards.
+        GLint packAlignment{4};
+        glGetIntegerv(GL_PACK_ALIGNMENT, &packAlignment);
+        if(packAlignment != 1)
+            glPixelStorei(GL_PACK_ALIGNMENT, 1);
+        glReadPixels(x, y, width, height, format, type, nullptr);
+        if(packAlignment != 1)
+            glPixelStorei(GL_PACK_ALIGNMENT, packAlignment);
+
+        //Reads into client memory must not go to the pack buffer.
+        GLStateCache::getCurrent().bindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+        slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        slot.callback = std::move(callback);
+        ++mPendingCount;
+    }
+
+    std::future<std::vector<ui8>> AsyncReadback::readPixels(i32 x, i32 y, i32 width, i32 height, GLenum format, GLenum type)
+    {
+        auto [callback, future] = makePromiseCallback();
+        readPixels(x, y, width, height, format, type, std::move(callback));
+
+        return std::move(future);
+    }
+
+    void AsyncReadback::readBuffer(GLuint buffer, ui32 offset, ui32 size, Callback callback)
+    {
+        assert(size > 0);
+
+        auto& slot = acquireSlot(size);
+        auto& stateCache = GLStateCache::getCurrent();
+
+        stateCache.bindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        stateCache.bindBuffer(GL_COPY_READ_BUFFER, buffer);
+        stateCache.bindBuffer(GL_COPY_WRITE_BUFFER, slot.buffer);
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, offset, 0, size);
+
+        slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        slot.callback = std::move(callback);
+        ++mPendingCount;
+    }
+
+    std::future<std::vector<ui8>> AsyncReadback::readBuffer(GLuint buffer, ui32 offset, ui32 size)
+    {
+        auto [callback, future] = makePromiseCallback();
+        readBuffer(buffer, offset, size, std::move(callback));
+
+        return std::move(future);
+    }
+
+    void AsyncReadback::poll(void)
+    {
+        mIsPolling = true;
+
+        try
+        {
+            while(mPendingCount > 0)
+            {
+                auto& slot = mSlots[mHeadIndex];
+                const GLenum waitResult = glClientWaitSync(slot.fence, 0, 0);
+                if(waitResult != GL_ALREADY_SIGNALED && waitResult != GL_CONDITION_SATISFIED)
+                    break;
+
+                mHeadIndex = (mHeadIndex + 1) % mSlots.size();
+                --mPendingCount;
+                complete(slot);
+            }
+        }
+        catch(...)
+        {
+            mIsPolling = false;
+            throw;
+        }
+
+        mIsPolling = false;
+    }
+
+    void AsyncReadback::complete(ReadbackSlot& slot)
+    {
+        glDeleteSync(slot.fence);
+        slot.fence = nullptr;
+        const auto callback = std::move(slot.callback);
+        slot.callback = nullptr;
+
+        auto& stateCache = GLStateCache::getCurrent();
+        stateCache.bindBuffer(GL_COPY_READ_BUFFER, slot.buffer);
+
+        const auto data = static_cast<const ui8*>(glMapBufferRange(GL_COPY_READ_BUFFER, 0, slot.size, GL_MAP_READ_BIT));
+        if(!data)
+            THROW_RS_EXCEPTION("(AsyncReadback::poll) : mapping the readback buffer failed.", RSErrorCode::BGL_MappingBufferFailed);
+
+        //The callback may bind other buffers.
+        const auto unmap = [&stateCache, &slot](void)
+        {
+            stateCache.bindBuffer(GL_COPY_READ_BUFFER, slot.buffer);
+            glUnmapBuffer(GL_COPY_READ_BUFFER);
+        };
+
+        try
+        {
+            callback(data, slot.size);
+        }
+        catch(...)
+        {
+            unmap();
+            throw;
+        }
+
+        unmap();
+    }
+}
\ No newline at end of file
@@ -31,7 +31,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "RS/Graphics/BaseGL/Texture.h"
 
 #include <chrono>
+#include <cmath>
 #include <thread>
+#include <utility>
 #include <cassert>
 
 using namespace std::chrono;
@@ -39,6 +41,28 @@ using namespace RS::Exception;
 
 namespace RS::Graphics::BaseGL
 {
+    namespace
+    {
+        RS_INLINE f32 getMilliseconds(steady_clock::time_point begin, steady_clock::time_point end)
+        {
+            return duration<f32, std::milli>(end - begin).count();
+        }
+
+        //Maps the "context.api" parameter to a GLFW context creation API.
+        i32 getContextCreationAPI(const std::string& api)
+        {
+            if(api == "native")
+                return GLFW_NATIVE_CONTEXT_API;
+            if(api == "egl")
+                return GLFW_EGL_CONTEXT_API;
+        #ifdef GLFW_OSMESA_CONTEXT_API
+            if(api == "osmesa")
+                return GLFW_OSMESA_CONTEXT_API;
+        #endif
+            THROW_RS_EXCEPTION("(BaseGLApp::initialize) : context API '" + api + "' is not supported.", RSErrorCode::BGL_ContextAPINotSupported);
+        }
+    }
+
     BaseGLApp* BaseGLApp::baseGLAppInstance = nullptr;
 
     BaseGLApp::BaseGLApp(void)
@@ -47,6 +71,16 @@ namespace RS::Graphics::BaseGL
         mConfigParameters.set("screen.width", 1280);
         mConfigParameters.set("screen.height", 720);
         mConfigParameters.set("screen.isFullScreen", false);
+        mConfigParameters.set("screen.lockToRefreshRate", false);
+        mConfigParameters.set("context.headless", false);
+        mConfigParameters.set("context.api", "native");
+        mConfigParameters.set("run.maxFrames", 0);
+        mConfigParameters.set("run.renderThread", false);
+        mConfigParameters.set("update.rate", 60);
+        mConfigParameters.set("update.maxStepsPerFrame", 5);
+        mConfigParameters.set("profiler.gpu", false);
+        mConfigParameters.set("shader.binaryCacheDirectory", "");
+        mConfigParameters.set("shader.hotReload", false);
     }
 
     BaseGLApp::~BaseGLApp(void)
@@ -58,6 +92,7 @@ namespace RS::Graphics::BaseGL
     {
         mScreenWidth = mConfigParameters.get<i32>("screen.width");
         mScreenHeight = mConfigParameters.get<i32>("screen.height");
+        mIsHeadless = mConfigParameters.get<bool>("context.headless");
 
         if (!glfwInit())
             THROW_RS_EXCEPTION("(BaseGLApp::initialize) : glfwInit() failed.", RSErrorCode::BGL_GLFWInitFailed);
@@ -70,17 +105,32 @@ namespace RS::Graphics::BaseGL
         //glfwWindowHint(GLFW_RESIZABLE, GL_TRUE);
         glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
 
-        
-        //Gets the primary monitor info-----------------------
-        GLFWmonitor* monitor = glfwGetPrimaryMonitor();
-        glfwGetMonitorPhysicalSize(monitor, &mMonitorInfo.physicalWidth, &mMonitorInfo.physicalHeight);
-        const GLFWvidmode * mode = glfwGetVideoMode(monitor);        
-        mMonitorInfo.screenWidth = mode->width;
-        mMonitorInfo.screenHeight = mode->height;
-        mMonitorInfo.refreshRate = mode->refreshRate;
-        //----------------------------------------------------
-
-        mIsFullScreen = mConfigParameters.get<bool>("screen.isFullScreen");
+        const std::string contextAPI = mConfigParameters.get<std::string>("context.api");
+        glfwWindowHint(GLFW_CONTEXT_CREATION_API, getContextCreationAPI(contextAPI));
+
+        GLFWmonitor* monitor = nullptr;
+        if(mIsHeadless)
+        {
+            //There may be no monitor at all, so the offscreen
+            //framebuffer plays the role of the screen.
+            glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+            mMonitorInfo = {mScreenWidth, mScreenHeight, 0, 0, 0};
+            mIsFullScreen = false;
+        }
+        else
+        {
+            //Gets the primary monitor info-----------------------
+            monitor = glfwGetPrimaryMonitor();
+            glfwGetMonitorPhysicalSize(monitor, &mMonitorInfo.physicalWidth, &mMonitorInfo.physicalHeight);
+            const GLFWvidmode * mode = glfwGetVideoMode(monitor);        
+            mMonitorInfo.screenWidth = mode->width;
+            mMonitorInfo.screenHeight = mode->height;
+            mMonitorInfo.refreshRate = mode->refreshRate;
+            //----------------------------------------------------
+
+            mIsFullScreen = mConfigParameters.get<bool>("screen.isFullScreen");
+        }
+
         if(mIsFullScreen)
             windowResized(mMonitorInfo.screenWidth, mMonitorInfo.screenHeight);
         else
@@ -103,58 +153,342 @@ namespace RS::Graphics::BaseGL
         glfwPollEvents();
 
         glewExperimental = GL_TRUE;
-        if (glewInit() != GLEW_OK)
+        const GLenum glewStatus = glewInit();
+        //GLEW built for GLX reports a missing GLX display for EGL/OSMesa
+        //contexts even though the entry points have been loaded.
+    #ifdef GLEW_ERROR_NO_GLX_DISPLAY
+        if (glewStatus != GLEW_OK && !(mIsHeadless && glewStatus == GLEW_ERROR_NO_GLX_DISPLAY))
+    #else
+        if (glewStatus != GLEW_OK)
+    #endif
         {
             glfwTerminate();
             THROW_RS_EXCEPTION("(BaseGLApp::initialize) : glewInit() failed.", RSErrorCode::BGL_GLEWInitFailed);
         }
+
+        GLStateCache::setCurrent(&mStateCache);
+        DeletionQueue::setCurrent(&mDeletionQueue);
+
+        if(mIsHeadless)
+        {
+            glfwSwapInterval(0);
+            mOffscreenFrameBuffer = std::make_unique<FrameBuffer>(mScreenWidth, mScreenHeight);
+            mOffscreenFrameBuffer->bind();
+        }
+
+        mGPUProfiler.setEnabled(mConfigParameters.get<bool>("profiler.gpu"));
+        mProgramBinaryCache.setDirectory(mConfigParameters.get<std::string>("shader.binaryCacheDirectory"));
+
+        if(mConfigParameters.get<bool>("screen.lockToRefreshRate") && mMonitorInfo.refreshRate > 0)
+            mFramePacer.setTargetInterval(1000.0 / mMonitorInfo.refreshRate);
     }
 
     void  BaseGLApp::setFPSLimit(ui32 fps)
     {
-        assert(fps != 0);
-
         mFPSLimit = fps;
-        mElapsedTimeLimit = (1000.0f / mFPSLimit);
+        mElapsedTimeLimit = (mFPSLimit > 0) ? (1000.0f / mFPSLimit) : 0.0f;
+
+        if(!mConfigParameters.get<bool>("screen.lockToRefreshRate"))
+            mFramePacer.setTargetInterval(mElapsedTimeLimit);
     }
 
     void BaseGLApp::run(void)
     {
+        //The default vertex array, for code that sets attribute pointers by hand. Geometry with a
+        //VertexLayout should use mVertexArrayCache or its own VertexArray.
         GLuint vertexArrayID;
 	    glGenVertexArrays(1, &vertexArrayID);
-	    glBindVertexArray(vertexArrayID);
+	    mStateCache.bindVertexArray(vertexArrayID);
+
+        mMaxFrames = mConfigParameters.get<ui64>("run.maxFrames");
+        mFrameNumber = 0;
+        mFramesDone = 0;
+        mFPSStartTime = steady_clock::now();
+        mLastFrameTime = steady_clock::now();
+        const ui32 updateRate = mConfigParameters.get<ui32>("update.rate");
+        mFixedDeltaTime = (updateRate > 0) ? 1000.0 / updateRate : 0.0;
+        mMaxUpdateStepsPerFrame = mConfigParameters.get<ui32>("update.maxStepsPerFrame");
+        mUpdateAccumulator = 0.0;
+
+        mFrameTimeRecorder.clear();
+        mFramePacer.reset();
+        mFrameScopeId = mGPUProfiler.getScopeId("frame");
+
+        if(mConfigParameters.get<bool>("shader.hotReload"))
+            mShaderHotReloader.start();
+
+        mUseRenderThread = mConfigParameters.get<bool>("run.renderThread");
+        if(mUseRenderThread)
+            runWithRenderThread();
+        else
+            runSingleThreaded();
 
-        i32 framesDone{0};
-        auto startTimeFPS = steady_clock::now();
-        auto lastTime = steady_clock::now();
+        mShaderHotReloader.stop();
+        shutdown();
+        mVertexArrayCache.clear();
+        mStateCache.onVertexArrayDeleted(vertexArrayID);
+        glDeleteVertexArrays(1, &vertexArrayID);
+        mGPUProfiler.releaseQueries();
+        mOffscreenFrameBuffer.reset();
+        mAsyncReadback.releaseBuffers();
+        mDeletionQueue.flush();
+        DeletionQueue::setCurrent(nullptr);
+        GLStateCache::setCurrent(nullptr);
+        glfwTerminate();
 
-        while (glfwGetKey(mWindow, GLFW_KEY_ESCAPE ) != GLFW_PRESS && glfwWindowShouldClose(mWindow) == 0)
+        if(mRenderThreadException)
+            std::rethrow_exception(std::exchange(mRenderThreadException, nullptr));
+    }
+
+    bool BaseGLApp::shouldClose(void)
+    {
+        return glfwGetKey(mWindow, GLFW_KEY_ESCAPE ) == GLFW_PRESS || glfwWindowShouldClose(mWindow) != 0;
+    }
+
+    void BaseGLApp::beginFrameClock(void)
+    {
+        const auto currentTime = steady_clock::now();
+        mElapsedTime = duration<double, std::milli>(currentTime - mLastFrameTime).count();
+        mLastFrameTime = currentTime;
+        
+        if(duration<double>(mLastFrameTime - mFPSStartTime).count() >= 1)
         {
-            glViewport(0, 0, mScreenWidth, mScreenHeight);        
-            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+            mFPS = mFramesDone;                
+            mFramesDone = 0;
+            mFPSStartTime = mLastFrameTime;
+        }
+        ++mFramesDone;
+    }
 
-            mElapsedTime = duration<double, std::milli>(steady_clock::now() - lastTime).count();
-            lastTime = steady_clock::now();
-            
-            if(duration<double>(lastTime - startTimeFPS).count() >= 1)
-            {
-                mFPS = framesDone;                
-                framesDone = 0;
-                startTimeFPS = steady_clock::now();
-            }
-            ++framesDone;
+    double BaseGLApp::updateSimulation(double elapsedTime)
+    {
+        if(mFixedDeltaTime <= 0.0)
+            return 1.0;
+
+        mUpdateAccumulator += elapsedTime;
+        for(ui32 step = 0; step < mMaxUpdateStepsPerFrame && mUpdateAccumulator >= mFixedDeltaTime; ++step)
+        {
+            update(mFixedDeltaTime);
+            mUpdateAccumulator -= mFixedDeltaTime;
+        }
 
-            render(mElapsedTime);
+        //Drops the time that could not be simulated in this frame
+        //rather than falling further behind in the next ones.
+        if(mUpdateAccumulator >= mFixedDeltaTime)
+            mUpdateAccumulator = std::fmod(mUpdateAccumulator, mFixedDeltaTime);
 
-            if(mFPSLimit > 0)
-                std::this_thread::sleep_for(duration<f32, std::milli>(mElapsedTimeLimit) - (steady_clock::now() - lastTime));
-            
+        return mUpdateAccumulator / mFixedDeltaTime;
+    }
+
+    void BaseGLApp::renderFrame(double interpolationAlpha, FrameSample* frameSample)
+    {
+        auto phaseStartTime = steady_clock::now();
+
+        mGPUProfiler.beginFrame();
+        mGPUProfiler.beginScope(mFrameScopeId);
+
+        glViewport(0, 0, mScreenWidth, mScreenHeight);        
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+        render(mElapsedTime, interpolationAlpha);
+        mGPUProfiler.endScope();
+        mGPUProfiler.endFrame();
+        auto phaseEndTime = steady_clock::now();
+        frameSample->renderTime = getMilliseconds(phaseStartTime, phaseEndTime);
+        phaseStartTime = phaseEndTime;
+
+        frameSample->pacerJitter = mFramePacer.wait();
+        phaseEndTime = steady_clock::now();
+        frameSample->limiterTime = getMilliseconds(phaseStartTime, phaseEndTime);
+        phaseStartTime = phaseEndTime;
+        
+        //Nothing is presented in headless mode, flushing keeps the GPU busy.
+        if(mIsHeadless)
+            glFlush();
+        else
             glfwSwapBuffers(mWindow);
+        phaseEndTime = steady_clock::now();
+        frameSample->swapTime = getMilliseconds(phaseStartTime, phaseEndTime);
+        phaseStartTime = phaseEndTime;
+
+        mDeletionQueue.endFrame();
+        mAsyncReadback.poll();
+        mShaderHotReloader.update();
+        frameSample->housekeepingTime = getMilliseconds(phaseStartTime, steady_clock::now());
+    }
+
+    bool BaseGLApp::finishFrame(FrameSample* frameSample)
+    {
+        frameSample->frameTime = getMilliseconds(mLastFrameTime, steady_clock::now());
+        mFrameTimeRecorder.record(*frameSample);
+
+        return (mMaxFrames == 0 || ++mFrameNumber < mMaxFrames);
+    }
+
+    void BaseGLApp::runSingleThreaded(void)
+    {
+        bool isRunning{true};
+        while (isRunning && !shouldClose())
+        {
+            beginFrameClock();
+
+            FrameSample frameSample;
+            auto phaseStartTime = steady_clock::now();
+
+            const double interpolationAlpha = updateSimulation(mElapsedTime);
+            prepareFrame(mFrameStateIndex.getWriteIndex(), interpolationAlpha);
+            mFrameStateIndex.publish();
+            mFrameStateIndex.acquire();
+            mRenderFrameSlot = mFrameStateIndex.getReadIndex();
+            frameSample.updateTime = getMilliseconds(phaseStartTime, steady_clock::now());
+
+            renderFrame(interpolationAlpha, &frameSample);
+
+            phaseStartTime = steady_clock::now();
             glfwPollEvents();
+            frameSample.pollTime = getMilliseconds(phaseStartTime, steady_clock::now());
+
+            isRunning = finishFrame(&frameSample);
         }
+    }
 
-        glDeleteVertexArrays(1, &vertexArrayID);
-        glfwTerminate();
+    void BaseGLApp::runWithRenderThread(void)
+    {
+        mPublishedFrameCount = 0;
+        mConsumedFrameCount = 0;
+        mIsRenderThreadRunning = true;
+
+        //The render thread owns the context until it exits. The deletion queue
+        //stays current, the resources released here are deleted by the render thread.
+        glfwMakeContextCurrent(nullptr);
+        GLStateCache::setCurrent(nullptr);
+        mRenderThread = std::thread(&BaseGLApp::renderThreadLoop, this);
+
+        //An exception of update() or prepareFrame() is rethrown once the render thread has been joined.
+        std::exception_ptr exception;
+        try
+        {
+            auto lastUpdateTime = steady_clock::now();
+            while (!shouldClose())
+            {
+                auto phaseStartTime = steady_clock::now();
+                glfwPollEvents();
+                const f32 pollTime = getMilliseconds(phaseStartTime, steady_clock::now());
+
+                //The write slot is always owned by this thread, so the next frame is prepared while
+                //the render thread draws the current one and the previous one may still wait in the
+                //shared slot: the application runs up to one frame ahead.
+                phaseStartTime = steady_clock::now();
+                const double elapsedTime = duration<double, std::milli>(phaseStartTime - lastUpdateTime).count();
+                lastUpdateTime = phaseStartTime;
+
+                const double interpolationAlpha = updateSimulation(elapsedTime);
+                const ui32 frameSlot = mFrameStateIndex.getWriteIndex();
+                prepareFrame(frameSlot, interpolationAlpha);
+                mFrameSlotInfo[frameSlot] = {interpolationAlpha, pollTime, getMilliseconds(phaseStartTime, steady_clock::now())};
+
+                {
+                    //Publishes only after the render thread has taken the previous
+                    //frame from the shared slot, so no prepared frame is dropped.
+                    std::unique_lock<std::mutex> lock(mFrameHandoffMutex);
+                    mFrameHandoffCondition.wait(lock, [this]
+                    {
+                        return mConsumedFrameCount == mPublishedFrameCount || !mIsRenderThreadRunning;
+                    });
+
+                    if(!mIsRenderThreadRunning)
+                        break;
+
+                    mFrameStateIndex.publish();
+                    ++mPublishedFrameCount;
+                }
+                mFrameHandoffCondition.notify_all();
+            }
+        }
+        catch(...)
+        {
+            exception = std::current_exception();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mFrameHandoffMutex);
+            mIsRenderThreadRunning = false;
+        }
+        mFrameHandoffCondition.notify_all();
+        mRenderThread.join();
+
+        glfwMakeContextCurrent(mWindow);
+        GLStateCache::setCurrent(&mStateCache);
+
+        if(exception)
+            std::rethrow_exception(exception);
+    }
+
+    void BaseGLApp::renderThreadLoop(void)
+    {
+        glfwMakeContextCurrent(mWindow);
+        GLStateCache::setCurrent(&mStateCache);
+        DeletionQueue::setCurrent(&mDeletionQueue);
+
+        try
+        {
+            bool isRunning{true};
+            while(isRunning)
+            {
+                {
+                    std::unique_lock<std::mutex> lock(mFrameHandoffMutex);
+                    mFrameHandoffCondition.wait(lock, [this]
+                    {
+                        return mPublishedFrameCount > mConsumedFrameCount || !mIsRenderThreadRunning;
+                    });
+
+                    if(!mIsRenderThreadRunning)
+                        break;
+
+                    mFrameStateIndex.acquire();
+                    mConsumedFrameCount = mPublishedFrameCount;
+                }
+                mFrameHandoffCondition.notify_all();
+
+                mRenderFrameSlot = mFrameStateIndex.getReadIndex();
+                const auto& frameSlotInfo = mFrameSlotInfo[mRenderFrameSlot];
+
+                beginFrameClock();
+
+                FrameSample frameSample;
+                frameSample.pollTime = frameSlotInfo.pollTime;
+                frameSample.updateTime = frameSlotInfo.updateTime;
+                renderFrame(frameSlotInfo.interpolationAlpha, &frameSample);
+
+                isRunning = finishFrame(&frameSample);
+            }
+        }
+        catch(...)
+        {
+            mRenderThreadException = std::current_exception();
+        }
+
+        glfwMakeContextCurrent(nullptr);
+        GLStateCache::setCurrent(nullptr);
+        DeletionQueue::setCurrent(nullptr);
+
+        {
+            std::lock_guard<std::mutex> lock(mFrameHandoffMutex);
+            mIsRenderThreadRunning = false;
+        }
+        mFrameHandoffCondition.notify_all();
+    }
+
+    void BaseGLApp::update(double)
+    {
+    }
+
+    void BaseGLApp::prepareFrame(ui32, double)
+    {
+    }
+
+    void BaseGLApp::shutdown(void)
+    {
     }
 
     void BaseGLApp::windowResized(i32 width, i32 height)
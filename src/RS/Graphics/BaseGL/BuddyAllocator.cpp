@@ -0,0 +1,151 @@
+/*
+BSD 2-Clause License
+Copyright (c) 2017, Davood Rasti and Alireza Rasti - rastisoft
+All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "RS/Graphics/BaseGL/BuddyAllocator.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace RS::Graphics::BaseGL
+{
+    BuddyAllocator::BuddyAllocator(ui32 capacity, ui32 minBlockSize) :
+        mMinBlockSize(minBlockSize),
+        mMaxOrder(0)
+    {
+        assert(minBlockSize > 0 && (minBlockSize & (minBlockSize - 1)) == 0);
+
+        while((mMinBlockSize << mMaxOrder) < capacity)
+            ++mMaxOrder;
+
+        mFreeBlocks.resize(mMaxOrder + 1);
+        mFreeBlocks[mMaxOrder].insert(0);
+    }
+
+    ui32 BuddyAllocator::getOrder(ui32 size) const noexcept
+    {
+        ui32 order{0};
+        while((mMinBlockSize << order) < size)
+            ++order;
+
+        return order;
+    }
+
+    ui32 BuddyAllocator::allocate(ui32 size)
+    {
+        if(size == 0 || size > getCapacity())
+            return InvalidOffset;
+
+        const ui32 order = getOrder(size);
+
+        //Finds the smallest free block that fits.
+        ui32 blockOrder = order;
+        while(blockOrder <= mMaxOrder && mFreeBlocks[blockOrder].empty())
+            ++blockOrder;
+
+        if(blockOrder > mMaxOrder)
+            return InvalidOffset;
+
+        const ui32 offset = *mFreeBlocks[blockOrder].begin();
+        mFreeBlocks[blockOrder].erase(mFreeBlocks[blockOrder].begin());
+
+        //Splits it down, the upper halves stay free.
+        while(blockOrder > order)
+        {
+            --blockOrder;
+            mFreeBlocks[blockOrder].insert(offset + (mMinBlockSize << blockOrder));
+        }
+
+        mAllocatedBlocks.emplace(offset, static_cast<ui8>(order));
+        mAllocatedSize += mMinBlockSize << order;
+
+        return offset;
+    }
+
+    void BuddyAllocator::free(ui32 offset)
+    {
+        const auto block = mAllocatedBlocks.find(offset);
+        assert(block != mAllocatedBlocks.end());
+
+        const ui32 order = block->second;
+        mAllocatedBlocks.erase(block);
+        mAllocatedSize -= mMinBlockSize << order;
+
+        releaseBlock(offset, order);
+    }
+
+    void BuddyAllocator::releaseBlock(ui32 offset, ui32 order)
+    {
+        while(order < mMaxOrder)
+        {
+            const ui32 buddy = offset ^ (mMinBlockSize << order);
+            if(mFreeBlocks[order].erase(buddy) == 0)
+                break;
+
+            offset = std::min(offset, buddy);
+            ++order;
+        }
+
+        mFreeBlocks[order].insert(offset);
+    }
+
+    void BuddyAllocator::grow(void)
+    {
+        assert(mMaxOrder < 31 && (static_cast<ui64>(mMinBlockSize) << (mMaxOrder + 1)) <= std::numeric_limits<ui32>::max());
+
+        const ui32 oldCapacity = getCapacity();
+
+        ++mMaxOrder;
+        mFreeBlocks.resize(mMaxOrder + 1);
+
+        //The new half is the buddy of the old range, so they merge if the old range is all free.
+        releaseBlock(oldCapacity, mMaxOrder - 1);
+    }
+
+    ui32 BuddyAllocator::getBlockSize(ui32 offset) const
+    {
+        const auto block = mAllocatedBlocks.find(offset);
+        assert(block != mAllocatedBlocks.end());
+
+        return mMinBlockSize << block->second;
+    }
+
+    ui32 BuddyAllocator::getLargestFreeBlock(void) const noexcept
+    {
+        for(ui32 order = mMaxOrder + 1; order-- > 0;)
+        {
+            if(!mFreeBlocks[order].empty())
+                return mMinBlockSize << order;
+        }
+
+        return 0;
+    }
+
+    f32 BuddyAllocator::getFragmentation(void) const noexcept
+    {
+        const ui32 freeSize = getFreeSize();
+        if(freeSize == 0)
+            return 0.0f;
+
+        return 1.0f - static_cast<f32>(getLargestFreeBlock()) / static_cast<f32>(freeSize);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,160 @@
+/*
+BSD 2-Clause License
+Copyright (c) 2017, Davood Rasti and Alireza Rasti - rastisoft
+All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "RS/Graphics/BaseGL/DeletionQueue.h"
+#include "RS/Graphics/BaseGL/GLStateCache.h"
+
+namespace RS::Graphics::BaseGL
+{
+    thread_local DeletionQueue* DeletionQueue::mCurrentDeletionQueue = nullptr;
+
+    DeletionQueue::DeletionQueue(bool isDeferred) :
+        mIsDeferred(isDeferred)
+    {
+    }
+
+    DeletionQueue::~DeletionQueue(void)
+    {
+        //Whatever is left can not be deleted without the context, only the fences are dropped.
+        for(auto& pendingFrame : mPendingFrames)
+            glDeleteSync(pendingFrame.fence);
+    }
+
+    DeletionQueue& DeletionQueue::getCurrent(void)
+    {
+        if(mCurrentDeletionQueue)
+            return *mCurrentDeletionQueue;
+
+        thread_local DeletionQueue defaultDeletionQueue(false);
+        return defaultDeletionQueue;
+    }
+
+    void DeletionQueue::setCurrent(DeletionQueue* deletionQueue)
+    {
+        mCurrentDeletionQueue = deletionQueue;
+    }
+
+    void DeletionQueue::release(GLObjectType type, GLuint name)
+    {
+        if(name == 0)
+            return;
+
+        if(!mIsDeferred)
+        {
+            deleteObject({type, name});
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        mFrameDeletions.push_back({type, name});
+    }
+
+    void DeletionQueue::endFrame(void)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            if(!mFrameDeletions.empty())
+            {
+                mPendingFrames.push_back({glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0), std::move(mFrameDeletions)});
+                mFrameDeletions.clear();
+            }
+        }
+
+        //The frames complete in order, so only the oldest ones are polled.
+        while(!mPendingFrames.empty())
+        {
+            auto& pendingFrame = mPendingFrames.front();
+            const GLenum waitResult = glClientWaitSync(pendingFrame.fence, 0, 0);
+            if(waitResult != GL_ALREADY_SIGNALED && waitResult != GL_CONDITION_SATISFIED)
+                break;
+
+            glDeleteSync(pendingFrame.fence);
+            for(const auto& deletion : pendingFrame.deletions)
+                deleteObject(deletion);
+
+            mPendingFrames.pop_front();
+        }
+    }
+
+    void DeletionQueue::flush(void)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            if(!mFrameDeletions.empty())
+            {
+                mPendingFrames.push_back({nullptr, std::move(mFrameDeletions)});
+                mFrameDeletions.clear();
+            }
+        }
+
+        for(auto& pendingFrame : mPendingFrames)
+        {
+            if(pendingFrame.fence)
+            {
+                glClientWaitSync(pendingFrame.fence, GL_SYNC_FLUSH_COMMANDS_BIT, GL_TIMEOUT_IGNORED);
+                glDeleteSync(pendingFrame.fence);
+            }
+
+            for(const auto& deletion : pendingFrame.deletions)
+                deleteObject(deletion);
+        }
+
+        mPendingFrames.clear();
+    }
+
+    void DeletionQueue::deleteObject(const PendingDeletion& deletion)
+    {
+        auto& stateCache = GLStateCache::getCurrent();
+
+        switch(deletion.type)
+        {
+            case GLObjectType::Buffer:
+                stateCache.onBufferDeleted(deletion.name);
+                glDeleteBuffers(1, &deletion.name);
+                break;
+            case GLObjectType::Texture:
+                stateCache.onTextureDeleted(deletion.name);
+                glDeleteTextures(1, &deletion.name);
+                break;
+            case GLObjectType::Program:
+                stateCache.onProgramDeleted(deletion.name);
+                glDeleteProgram(deletion.name);
+                break;
+            case GLObjectType::Shader:
+                glDeleteShader(deletion.name);
+                break;
+            case GLObjectType::VertexArray:
+                stateCache.onVertexArrayDeleted(deletion.name);
+                glDeleteVertexArrays(1, &deletion.name);
+                break;
+            case GLObjectType::FrameBuffer:
+                glDeleteFramebuffers(1, &deletion.name);
+                break;
+            case GLObjectType::RenderBuffer:
+                glDeleteRenderbuffers(1, &deletion.name);
+                break;
+        }
+
+        ++mDeletedObjectCount;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,103 @@
+/*
+BSD 2-Clause License
+Copyright (c) 2017, Davood Rasti and Alireza Rasti - rastisoft
+All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "RS/Graphics/BaseGL/FrameBuffer.h"
+#include "RS/Exception/RSException.h"
+#include "RS/Graphics/BaseGL/DeletionQueue.h"
+
+#include <utility>
+
+using namespace RS::Exception;
+
+namespace RS::Graphics::BaseGL
+{
+    FrameBuffer::FrameBuffer(i32 width, i32 height) :
+        mWidth(width),
+        mHeight(height)
+    {
+        glGenFramebuffers(1, &mFrameBufferHandle);
+        glBindFramebuffer(GL_FRAMEBUFFER, mFrameBufferHandle);
+
+        glGenRenderbuffers(1, &mColorRenderBufferHandle);
+        glBindRenderbuffer(GL_RENDERBUFFER, mColorRenderBufferHandle);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, mWidth, mHeight);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, mColorRenderBufferHandle);
+
+        glGenRenderbuffers(1, &mDepthRenderBufferHandle);
+        glBindRenderbuffer(GL_RENDERBUFFER, mDepthRenderBufferHandle);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, mWidth, mHeight);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, mDepthRenderBufferHandle);
+
+        glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+        const GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+        //The destructor does not run for a throwing constructor, so the names are released here.
+        if(status != GL_FRAMEBUFFER_COMPLETE)
+        {
+            release();
+            THROW_RS_EXCEPTION("(FrameBuffer) : framebuffer is incomplete.", RSErrorCode::BGL_FrameBufferIncomplete);
+        }
+    }
+
+    FrameBuffer::FrameBuffer(FrameBuffer&& other) noexcept :
+        mFrameBufferHandle(std::exchange(other.mFrameBufferHandle, 0)),
+        mColorRenderBufferHandle(std::exchange(other.mColorRenderBufferHandle, 0)),
+        mDepthRenderBufferHandle(std::exchange(other.mDepthRenderBufferHandle, 0)),
+        mWidth(other.mWidth),
+        mHeight(other.mHeight)
+    {
+    }
+
+    FrameBuffer& FrameBuffer::operator=(FrameBuffer&& other) noexcept
+    {
+        if(this != &other)
+        {
+            release();
+            mFrameBufferHandle = std::exchange(other.mFrameBufferHandle, 0);
+            mColorRenderBufferHandle = std::exchange(other.mColorRenderBufferHandle, 0);
+            mDepthRenderBufferHandle = std::exchange(other.mDepthRenderBufferHandle, 0);
+            mWidth = other.mWidth;
+            mHeight = other.mHeight;
+        }
+
+        return *this;
+    }
+
+    FrameBuffer::~FrameBuffer(void)
+    {
+        release();
+    }
+
+    void FrameBuffer::release(void)
+    {
+        auto& deletionQueue = DeletionQueue::getCurrent();
+        deletionQueue.release(GLObjectType::RenderBuffer, mDepthRenderBufferHandle);
+        deletionQueue.release(GLObjectType::RenderBuffer, mColorRenderBufferHandle);
+        deletionQueue.release(GLObjectType::FrameBuffer, mFrameBufferHandle);
+        mDepthRenderBufferHandle = 0;
+        mColorRenderBufferHandle = 0;
+        mFrameBufferHandle = 0;
+    }
+}
\ No newline at end of file
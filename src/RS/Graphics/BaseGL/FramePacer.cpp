@@ -0,0 +1,92 @@
+/*
+BSD 2-Clause License
+Copyright (c) 2017, Davood Rasti and Alireza Rasti - rastisoft
+All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "RS/Graphics/BaseGL/FramePacer.h"
+
+#include <algorithm>
+#include <thread>
+
+using namespace std::chrono;
+
+namespace RS::Graphics::BaseGL
+{
+    namespace
+    {
+        constexpr double minSpinThreshold{0.25};
+        constexpr double maxSpinThreshold{4.0};
+        //How fast the spin window shrinks back after a large overshoot.
+        constexpr double spinThresholdDecay{0.99};
+    }
+
+    void FramePacer::setTargetInterval(double interval)
+    {
+        mTargetInterval = duration_cast<Clock::duration>(duration<double, std::milli>(std::max(interval, 0.0)));
+        reset();
+    }
+
+    void FramePacer::reset(void)
+    {
+        mNextDeadline = Clock::now() + mTargetInterval;
+        mLastJitter = 0.0f;
+    }
+
+    f32 FramePacer::wait(void)
+    {
+        if(mTargetInterval == Clock::duration::zero())
+            return 0.0f;
+
+        const auto deadline = mNextDeadline;
+        auto now = Clock::now();
+
+        if(now >= deadline)
+            ++mMissedDeadlineCount;
+        else
+        {
+            const auto sleepUntil = deadline - duration_cast<Clock::duration>(duration<double, std::milli>(mSpinThreshold));
+            if(now < sleepUntil)
+            {
+                std::this_thread::sleep_until(sleepUntil);
+                now = Clock::now();
+
+                const double overshoot = duration<double, std::milli>(now - sleepUntil).count();
+                mSpinThreshold = std::clamp(std::max(overshoot * 1.25, mSpinThreshold * spinThresholdDecay),
+                                            minSpinThreshold, maxSpinThreshold);
+            }
+
+            while(now < deadline)
+            {
+                std::this_thread::yield();
+                now = Clock::now();
+            }
+        }
+
+        //For a missed deadline it is the overrun of the frame.
+        mLastJitter = duration<f32, std::milli>(now - deadline).count();
+
+        mNextDeadline = deadline + mTargetInterval;
+        if(mNextDeadline <= now)
+            mNextDeadline = now + mTargetInterval;
+
+        return mLastJitter;
+    }
+}
\ No newline at end of file
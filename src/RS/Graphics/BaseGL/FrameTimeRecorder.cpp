@@ -0,0 +1,114 @@
+/*
+BSD 2-Clause License
+Copyright (c) 2017, Davood Rasti and Alireza Rasti - rastisoft
+All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "RS/Graphics/BaseGL/FrameTimeRecorder.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace RS::Graphics::BaseGL
+{
+    namespace
+    {
+        //Nearest-rank percentile of a sorted list.
+        f32 getPercentile(const std::vector<f32>& sortedValues, f32 percentile)
+        {
+            const auto rank = static_cast<size_t>(std::ceil(percentile * 0.01f * sortedValues.size()));
+            return sortedValues[std::clamp<size_t>(rank, 1, sortedValues.size()) - 1];
+        }
+
+        TimingSummary summarize(const std::vector<FrameSample>& samples, f32 FrameSample::* phase, std::vector<f32>* values)
+        {
+            values->clear();
+            double sum{0.0};
+            for(const auto& sample : samples)
+            {
+                values->push_back(sample.*phase);
+                sum += sample.*phase;
+            }
+
+            std::sort(values->begin(), values->end());
+
+            TimingSummary summary;
+            summary.min = values->front();
+            summary.avg = static_cast<f32>(sum / values->size());
+            summary.p50 = getPercentile(*values, 50.0f);
+            summary.p95 = getPercentile(*values, 95.0f);
+            summary.p99 = getPercentile(*values, 99.0f);
+            summary.max = values->back();
+
+            return summary;
+        }
+    }
+
+    ui32 FrameTimeRecorder::copyLatest(FrameSample* outSamples, ui32 sampleCount) const noexcept
+    {
+        const ui64 endIndex = mWriteIndex.load(std::memory_order_acquire);
+        sampleCount = static_cast<ui32>(std::min<ui64>({sampleCount, endIndex, capacity}));
+        const ui64 beginIndex = endIndex - sampleCount;
+
+        for(ui64 index = beginIndex; index < endIndex; ++index)
+            outSamples[index - beginIndex] = mSamples[index % capacity];
+
+        //The writer may have wrapped around while copying, the samples it
+        //could have touched are the ones older than its current position.
+        std::atomic_thread_fence(std::memory_order_acquire);
+        const ui64 writeIndex = mWriteIndex.load(std::memory_order_relaxed);
+        const ui64 firstValidIndex = (writeIndex >= capacity) ? writeIndex - capacity + 1 : 0;
+        if(firstValidIndex <= beginIndex)
+            return sampleCount;
+        if(firstValidIndex >= endIndex)
+            return 0;
+
+        const ui32 droppedCount = static_cast<ui32>(firstValidIndex - beginIndex);
+        std::copy(outSamples + droppedCount, outSamples + sampleCount, outSamples);
+
+        return sampleCount - droppedCount;
+    }
+
+    FrameStatistics FrameTimeRecorder::getStatistics(ui32 frameCount) const
+    {
+        std::vector<FrameSample> samples(std::min(frameCount, capacity));
+        samples.resize(copyLatest(samples.data(), samples.size()));
+
+        FrameStatistics statistics;
+        statistics.frameCount = samples.size();
+        if(samples.empty())
+            return statistics;
+
+        std::vector<f32> values;
+        values.reserve(samples.size());
+
+        statistics.pollTime = summarize(samples, &FrameSample::pollTime, &values);
+        statistics.updateTime = summarize(samples, &FrameSample::updateTime, &values);
+        statistics.renderTime = summarize(samples, &FrameSample::renderTime, &values);
+        statistics.limiterTime = summarize(samples, &FrameSample::limiterTime, &values);
+        statistics.swapTime = summarize(samples, &FrameSample::swapTime, &values);
+        statistics.housekeepingTime = summarize(samples, &FrameSample::housekeepingTime, &values);
+        statistics.frameTime = summarize(samples, &FrameSample::frameTime, &values);
+        statistics.pacerJitter = summarize(samples, &FrameSample::pacerJitter, &values);
+
+        return statistics;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,93 @@
+/*
+BSD 2-Clause License
+Copyright (c) 2017, Davood Rasti and Alireza Rasti - rastisoft
+All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "RS/Graphics/BaseGL/GLStateCache.h"
+
+namespace RS::Graphics::BaseGL
+{
+    thread_local GLStateCache* GLStateCache::mCurrentStateCache = nullptr;
+
+    GLStateCache::GLStateCache(bool isEnabled) :
+        mIsEnabled(isEnabled)
+    {
+        invalidate();
+    }
+
+    GLStateCache& GLStateCache::getCurrent(void)
+    {
+        if(mCurrentStateCache)
+            return *mCurrentStateCache;
+
+        thread_local GLStateCache defaultStateCache(false);
+        return defaultStateCache;
+    }
+
+    void GLStateCache::setCurrent(GLStateCache* stateCache)
+    {
+        mCurrentStateCache = stateCache;
+    }
+
+    void GLStateCache::invalidate(void)
+    {
+        mBuffers.fill(unknownBinding);
+        mTextures.fill(unknownBinding);
+        mProgram = unknownBinding;
+        mVertexArray = unknownBinding;
+        mActiveTextureUnit = unknownBinding;
+    }
+
+    void GLStateCache::onProgramDeleted(GLuint program)
+    {
+        //A deleted program stays in use until another one is used,
+        //so the binding is only forgotten.
+        if(mProgram == program)
+            mProgram = unknownBinding;
+    }
+
+    void GLStateCache::onVertexArrayDeleted(GLuint vertexArray)
+    {
+        if(mVertexArray == vertexArray)
+        {
+            mVertexArray = 0;
+            mBuffers[ElementArrayBuffer] = unknownBinding;
+        }
+    }
+
+    void GLStateCache::onBufferDeleted(GLuint buffer)
+    {
+        for(auto& boundBuffer : mBuffers)
+        {
+            if(boundBuffer == buffer)
+                boundBuffer = 0;
+        }
+    }
+
+    void GLStateCache::onTextureDeleted(GLuint texture)
+    {
+        for(auto& boundTexture : mTextures)
+        {
+            if(boundTexture == texture)
+                boundTexture = 0;
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,182 @@
+/*
+BSD 2-Clause License
+Copyright (c) 2017, Davood Rasti and Alireza Rasti - rastisoft
+All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "RS/Graphics/BaseGL/GPUProfiler.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace RS::Graphics::BaseGL
+{
+    namespace
+    {
+        //Weight of the latest sample in the moving average.
+        constexpr f32 averageFactor{0.05f};
+    }
+
+    GPUProfiler::~GPUProfiler(void)
+    {
+        releaseQueries();
+    }
+
+    void GPUProfiler::releaseQueries(void)
+    {
+        assert(!mIsInFrame);
+
+        for(auto& frame : mFrames)
+        {
+            if(!frame.queries.empty())
+                glDeleteQueries(frame.queries.size(), frame.queries.data());
+
+            frame = FrameQueries();
+        }
+    }
+
+    void GPUProfiler::setEnabled(bool isEnabled)
+    {
+        assert(!mIsInFrame);
+        mIsEnabled = isEnabled;
+    }
+
+    ui32 GPUProfiler::getScopeId(const std::string& name)
+    {
+        if(const auto iterator = mScopeIds.find(name); iterator != mScopeIds.end())
+            return iterator->second;
+
+        std::lock_guard<std::mutex> lock(mScopeTimingsMutex);
+        const ui32 scopeId = mScopeTimings.size();
+        mScopeIds.emplace(name, scopeId);
+        mScopeTimings.push_back(ScopeTiming{name});
+
+        return scopeId;
+    }
+
+    ui32 GPUProfiler::getQuery(FrameQueries& frame)
+    {
+        if(frame.usedQueryCount == frame.queries.size())
+        {
+            //Grows the pool of this frame, the queries are reused from now on.
+            const ui32 newQueryCount = std::max<ui32>(16, frame.queries.size());
+            frame.queries.resize(frame.queries.size() + newQueryCount);
+            glGenQueries(newQueryCount, &frame.queries[frame.usedQueryCount]);
+        }
+
+        return frame.usedQueryCount++;
+    }
+
+    void GPUProfiler::collect(FrameQueries& frame)
+    {
+        if(!frame.isPending)
+            return;
+
+        frame.isPending = false;
+        if(frame.scopes.empty())
+            return;
+
+        GLint isAvailable{0};
+        glGetQueryObjectiv(frame.queries[frame.usedQueryCount - 1], GL_QUERY_RESULT_AVAILABLE, &isAvailable);
+        if(!isAvailable)
+        {
+            ++mDroppedFrameCount;
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(mScopeTimingsMutex);
+        for(const auto& scope : frame.scopes)
+        {
+            GLuint64 beginTime{0};
+            GLuint64 endTime{0};
+            glGetQueryObjectui64v(frame.queries[scope.beginQueryIndex], GL_QUERY_RESULT, &beginTime);
+            glGetQueryObjectui64v(frame.queries[scope.endQueryIndex], GL_QUERY_RESULT, &endTime);
+
+            const f32 time = (endTime > beginTime) ? (endTime - beginTime) * 1.0e-6f : 0.0f;
+            auto& timing = mScopeTimings[scope.scopeId];
+            timing.lastTime = time;
+            timing.avgTime = (timing.sampleCount == 0) ? time : timing.avgTime + (time - timing.avgTime) * averageFactor;
+            timing.maxTime = std::max(timing.maxTime, time);
+            ++timing.sampleCount;
+        }
+    }
+
+    void GPUProfiler::beginFrame(void)
+    {
+        if(!mIsEnabled)
+            return;
+
+        assert(!mIsInFrame);
+        mIsInFrame = true;
+
+        auto& frame = mFrames[mFrameIndex % frameLatency];
+        collect(frame);
+        frame.scopes.clear();
+        frame.usedQueryCount = 0;
+    }
+
+    void GPUProfiler::endFrame(void)
+    {
+        if(!mIsEnabled)
+            return;
+
+        assert(mIsInFrame && mOpenScopes.empty());
+        mIsInFrame = false;
+
+        mFrames[mFrameIndex % frameLatency].isPending = true;
+        ++mFrameIndex;
+    }
+
+    void GPUProfiler::beginScope(ui32 scopeId)
+    {
+        if(!mIsEnabled)
+            return;
+
+        assert(mIsInFrame && scopeId < mScopeTimings.size());
+
+        auto& frame = mFrames[mFrameIndex % frameLatency];
+        const ui32 queryIndex = getQuery(frame);
+        glQueryCounter(frame.queries[queryIndex], GL_TIMESTAMP);
+
+        mOpenScopes.push_back(frame.scopes.size());
+        frame.scopes.push_back(ScopeQuery{scopeId, queryIndex, queryIndex});
+    }
+
+    void GPUProfiler::endScope(void)
+    {
+        if(!mIsEnabled)
+            return;
+
+        assert(!mOpenScopes.empty());
+
+        auto& frame = mFrames[mFrameIndex % frameLatency];
+        const ui32 queryIndex = getQuery(frame);
+        glQueryCounter(frame.queries[queryIndex], GL_TIMESTAMP);
+
+        frame.scopes[mOpenScopes.back()].endQueryIndex = queryIndex;
+        mOpenScopes.pop_back();
+    }
+
+    std::vector<ScopeTiming> GPUProfiler::getScopeTimings(void) const
+    {
+        std::lock_guard<std::mutex> lock(mScopeTimingsMutex);
+        return mScopeTimings;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,188 @@
+/*
+BSD 2-Clause License
+Copyright (c) 2017, Davood Rasti and Alireza Rasti - rastisoft
+All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "RS/Graphics/BaseGL/ProgramBinaryCache.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+namespace RS::Graphics::BaseGL
+{
+    namespace
+    {
+        //"RSPB", bumped together with version when the file layout changes.
+        constexpr ui32 fileMagic{0x42505352};
+        constexpr ui32 fileVersion{1};
+
+        struct BinaryFileHeader
+        {
+            ui32                    magic;
+            ui32                    version;
+            ui64                    key;
+            ui32                    binaryFormat;
+            ui32                    binarySize;
+        };
+
+        std::string_view getGLString(GLenum name)
+        {
+            const auto string = reinterpret_cast<const char*>(glGetString(name));
+            return string ? std::string_view(string) : std::string_view();
+        }
+    }
+
+    ProgramBinaryCache::ProgramBinaryCache(const std::string& directory) :
+        mDirectory(directory)
+    {
+    }
+
+    void ProgramBinaryCache::setDirectory(const std::string& directory)
+    {
+        mDirectory = directory;
+    }
+
+    void ProgramBinaryCache::initialize(void)
+    {
+        if(mIsInitialized)
+            return;
+
+        mIsInitialized = true;
+
+        GLint formatCount{0};
+        if(GLEW_VERSION_4_1 || GLEW_ARB_get_program_binary)
+            glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+        mIsSupported = (formatCount > 0);
+
+        mDriverHash = hash(getGLString(GL_VENDOR));
+        mDriverHash = hash(getGLString(GL_RENDERER), mDriverHash);
+        mDriverHash = hash(getGLString(GL_VERSION), mDriverHash);
+    }
+
+    bool ProgramBinaryCache::isEnabled(void)
+    {
+        initialize();
+        return mIsSupported && !mDirectory.empty();
+    }
+
+    ui64 ProgramBinaryCache::getKey(ui64 sourcesHash)
+    {
+        initialize();
+
+        //Mixes the driver hash in byte by byte, like the sources.
+        return hash(std::string_view(reinterpret_cast<const char*>(&mDriverHash), sizeof(mDriverHash)), sourcesHash);
+    }
+
+    std::string ProgramBinaryCache::getFilePath(ui64 key) const
+    {
+        char fileName[32];
+        std::snprintf(fileName, sizeof(fileName), "%016llx.bin", static_cast<unsigned long long>(key));
+
+        return (std::filesystem::path(mDirectory) / fileName).string();
+    }
+
+    void ProgramBinaryCache::prepare(GLuint program)
+    {
+        if(isEnabled())
+            glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
+
+    bool ProgramBinaryCache::load(ui64 key, GLuint program)
+    {
+        if(!isEnabled())
+            return false;
+
+        const std::string filePath = getFilePath(key);
+        std::ifstream inStream(filePath, std::ios::in | std::ios::binary);
+        if(!inStream.is_open())
+        {
+            ++mMissCount;
+            return false;
+        }
+
+        BinaryFileHeader header;
+        std::vector<char> binary;
+        bool isValid = static_cast<bool>(inStream.read(reinterpret_cast<char*>(&header), sizeof(header)));
+        isValid = isValid && header.magic == fileMagic && header.version == fileVersion && header.key == key;
+        if(isValid)
+        {
+            binary.resize(header.binarySize);
+            isValid = static_cast<bool>(inStream.read(binary.data(), binary.size()));
+        }
+        inStream.close();
+
+        GLint status{0};
+        if(isValid)
+        {
+            glProgramBinary(program, header.binaryFormat, binary.data(), static_cast<GLsizei>(binary.size()));
+            glGetProgramiv(program, GL_LINK_STATUS, &status);
+        }
+
+        if(status == 0)
+        {
+            //Corrupt or rejected by the driver, it is replaced after the program is compiled from source.
+            std::error_code errorCode;
+            std::filesystem::remove(filePath, errorCode);
+            ++mMissCount;
+            return false;
+        }
+
+        ++mHitCount;
+        return true;
+    }
+
+    void ProgramBinaryCache::store(ui64 key, GLuint program)
+    {
+        if(!isEnabled())
+            return;
+
+        GLint binarySize{0};
+        glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &binarySize);
+        if(binarySize <= 0)
+            return;
+
+        std::vector<char> binary(binarySize);
+        GLenum binaryFormat{0};
+        glGetProgramBinary(program, binarySize, nullptr, &binaryFormat, binary.data());
+
+        std::error_code errorCode;
+        std::filesystem::create_directories(mDirectory, errorCode);
+
+        //Written to a temporary file first, so a concurrent reader never sees a partial binary.
+        const std::string filePath = getFilePath(key);
+        const std::string temporaryFilePath = filePath + ".tmp";
+        std::ofstream outStream(temporaryFilePath, std::ios::out | std::ios::binary | std::ios::trunc);
+        if(!outStream.is_open())
+            return;
+
+        const BinaryFileHeader header{fileMagic, fileVersion, key, binaryFormat, static_cast<ui32>(binarySize)};
+        outStream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        outStream.write(binary.data(), binary.size());
+        outStream.close();
+
+        if(outStream.good())
+            std::filesystem::rename(temporaryFilePath, filePath, errorCode);
+        else
+            std::filesystem::remove(temporaryFilePath, errorCode);
+    }
+}
\ No newline at end of file
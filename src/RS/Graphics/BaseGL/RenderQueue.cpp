@@ -0,0 +1,195 @@
+/*
+BSD 2-Clause License
+Copyright (c) 2017, Davood Rasti and Alireza Rasti - rastisoft
+All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "RS/Graphics/BaseGL/RenderQueue.h"
+#include "RS/Graphics/BaseGL/GLStateCache.h"
+#include "RS/Graphics/BaseGL/Shader.h"
+
+#include <cassert>
+#include <cstring>
+
+namespace RS::Graphics::BaseGL
+{
+    namespace
+    {
+        ui32 getUniformSize(GLenum type)
+        {
+            switch(type)
+            {
+                case GL_FLOAT:
+                case GL_INT:
+                    return 4;
+                case GL_FLOAT_VEC2:
+                    return 8;
+                case GL_FLOAT_VEC3:
+                    return 12;
+                case GL_FLOAT_VEC4:
+                    return 16;
+                case GL_FLOAT_MAT3:
+                    return 36;
+                case GL_FLOAT_MAT4:
+                    return 64;
+                default:
+                    assert(0 && "Unsupported uniform type.");
+                    return 0;
+            }
+        }
+    }
+
+    void RenderQueue::add(const DrawPacket& packet)
+    {
+        mPackets.push_back(packet);
+        mPackets.back().uniformBegin = mUniforms.size();
+        mPackets.back().uniformCount = 0;
+        mIsSorted = false;
+    }
+
+    void RenderQueue::addUniform(GLint location, GLenum type, const void* data, GLsizei count)
+    {
+        assert(!mPackets.empty());
+
+        const ui32 size = getUniformSize(type) * count;
+        const ui32 dataOffset = mUniformData.size();
+        mUniformData.resize(dataOffset + size);
+        std::memcpy(&mUniformData[dataOffset], data, size);
+
+        mUniforms.push_back(UniformCommand{location, type, count, dataOffset});
+        ++mPackets.back().uniformCount;
+    }
+
+    void RenderQueue::sort(void)
+    {
+        const ui32 packetCount = mPackets.size();
+        mSortEntries.resize(packetCount);
+        mSortBuffer.resize(packetCount);
+
+        for(ui32 index = 0; index < packetCount; ++index)
+            mSortEntries[index] = SortEntry{mPackets[index].sortKey, index};
+
+        std::array<ui32, 256> histogram;
+        for(ui32 shift = 0; shift < 64; shift += 8)
+        {
+            histogram.fill(0);
+            for(const auto& entry : mSortEntries)
+                ++histogram[(entry.key >> shift) & 0xFF];
+
+            //All keys have the same byte here, the order would not change.
+            if(histogram[(mSortEntries.empty()) ? 0 : (mSortEntries[0].key >> shift) & 0xFF] == packetCount)
+                continue;
+
+            ui32 offset{0};
+            for(auto& bucket : histogram)
+            {
+                const ui32 bucketSize = bucket;
+                bucket = offset;
+                offset += bucketSize;
+            }
+
+            for(const auto& entry : mSortEntries)
+                mSortBuffer[histogram[(entry.key >> shift) & 0xFF]++] = entry;
+
+            mSortEntries.swap(mSortBuffer);
+        }
+
+        mIsSorted = true;
+    }
+
+    void RenderQueue::applyUniform(Shader& shader, const UniformCommand& uniform)
+    {
+        shader.setUniform(uniform.location, uniform.type, &mUniformData[uniform.dataOffset], uniform.count);
+    }
+
+    void RenderQueue::submit(void)
+    {
+        if(!mIsSorted)
+            sort();
+
+        auto& stateCache = GLStateCache::getCurrent();
+        const bool wasBlendEnabled = glIsEnabled(GL_BLEND) == GL_TRUE;
+        bool isTranslucent{false};
+        bool isBlendFuncSet{false};
+        if(wasBlendEnabled)
+            glDisable(GL_BLEND);
+
+        for(const auto& entry : mSortEntries)
+        {
+            const auto& packet = mPackets[entry.packetIndex];
+
+            if(!isTranslucent && (packet.sortKey & translucentBit))
+            {
+                isTranslucent = true;
+                glEnable(GL_BLEND);
+                glDepthMask(GL_FALSE);
+
+                if(!isBlendFuncSet)
+                {
+                    isBlendFuncSet = true;
+                    glBlendFunc(mSourceBlendFactor, mDestinationBlendFactor);
+                }
+            }
+            else if(isTranslucent && !(packet.sortKey & translucentBit))
+            {
+                //A new layer starts with its opaque packets.
+                isTranslucent = false;
+                glDisable(GL_BLEND);
+                glDepthMask(GL_TRUE);
+            }
+
+            assert(packet.shader);
+            packet.shader->use();
+            stateCache.bindVertexArray(packet.vertexArray);
+
+            for(ui32 unit = 0; unit < DrawPacket::maxTextures; ++unit)
+            {
+                if(packet.textures[unit] != 0)
+                    stateCache.bindTexture(unit, GL_TEXTURE_2D, packet.textures[unit]);
+            }
+
+            for(ui32 index = 0; index < packet.uniformCount; ++index)
+                applyUniform(*packet.shader, mUniforms[packet.uniformBegin + index]);
+
+            if(packet.indexType == 0)
+                glDrawArrays(packet.primitive, packet.offset, packet.count);
+            else
+                glDrawElements(packet.primitive, packet.count, packet.indexType, reinterpret_cast<const void*>(packet.offset));
+        }
+
+        glDepthMask(GL_TRUE);
+        if(isTranslucent != wasBlendEnabled)
+        {
+            if(wasBlendEnabled)
+                glEnable(GL_BLEND);
+            else
+                glDisable(GL_BLEND);
+        }
+    }
+
+    void RenderQueue::clear(void)
+    {
+        mPackets.clear();
+        mUniforms.clear();
+        mUniformData.clear();
+        mSortEntries.clear();
+        mIsSorted = false;
+    }
+}
\ No newline at end of file
@@ -23,32 +23,552 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "RS/Graphics/BaseGL/Shader.h"
 #include "RS/Exception/RSException.h"
+#include "RS/Graphics/BaseGL/DeletionQueue.h"
+#include <algorithm>
 #include <cassert>
+#include <cstring>
 #include <fstream>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
 
 using namespace RS::Exception;
 
 namespace RS::Graphics::BaseGL
 {
+    namespace
+    {
+        template <class TVariable>
+        const TVariable* findByName(const std::vector<TVariable>& variables, const std::string_view& name)
+        {
+            const auto iterator = std::lower_bound(variables.begin(), variables.end(), name,
+                                                   [](const TVariable& variable, const std::string_view& value) { return variable.name < value; });
+            return (iterator != variables.end() && iterator->name == name) ? &*iterator : nullptr;
+        }
+
+        bool isSamplerType(GLenum type) noexcept
+        {
+            switch(type)
+            {
+                case GL_SAMPLER_1D:
+                case GL_SAMPLER_2D:
+                case GL_SAMPLER_3D:
+                case GL_SAMPLER_CUBE:
+                case GL_SAMPLER_1D_SHADOW:
+                case GL_SAMPLER_2D_SHADOW:
+                case GL_SAMPLER_1D_ARRAY:
+                case GL_SAMPLER_2D_ARRAY:
+                case GL_SAMPLER_1D_ARRAY_SHADOW:
+                case GL_SAMPLER_2D_ARRAY_SHADOW:
+                case GL_SAMPLER_CUBE_SHADOW:
+                case GL_SAMPLER_2D_MULTISAMPLE:
+                case GL_SAMPLER_2D_MULTISAMPLE_ARRAY:
+                case GL_SAMPLER_BUFFER:
+                case GL_SAMPLER_2D_RECT:
+                case GL_SAMPLER_2D_RECT_SHADOW:
+                case GL_INT_SAMPLER_2D:
+                case GL_INT_SAMPLER_3D:
+                case GL_INT_SAMPLER_CUBE:
+                case GL_INT_SAMPLER_2D_ARRAY:
+                case GL_INT_SAMPLER_BUFFER:
+                case GL_UNSIGNED_INT_SAMPLER_2D:
+                case GL_UNSIGNED_INT_SAMPLER_3D:
+                case GL_UNSIGNED_INT_SAMPLER_CUBE:
+                case GL_UNSIGNED_INT_SAMPLER_2D_ARRAY:
+                case GL_UNSIGNED_INT_SAMPLER_BUFFER:
+                    return true;
+                default:
+                    return false;
+            }
+        }
+
+        //Size of the uniform types that are shadowed, 0 for the others.
+        ui32 getUniformValueSize(GLenum type) noexcept
+        {
+            switch(type)
+            {
+                case GL_FLOAT:
+                case GL_INT:
+                case GL_BOOL:
+                    return 4;
+                case GL_FLOAT_VEC2:
+                    return 8;
+                case GL_FLOAT_VEC3:
+                case GL_BOOL_VEC3:
+                    return 12;
+                case GL_FLOAT_VEC4:
+                    return 16;
+                case GL_FLOAT_MAT3:
+                    return 36;
+                case GL_FLOAT_MAT4:
+                    return 64;
+                default:
+                    return isSamplerType(type) ? 4 : 0;
+            }
+        }
+
+        //Compares 16 bytes at a time, so a matrix takes a few vector compares.
+        bool isEqual(const ui8* left, const ui8* right, ui32 size) noexcept
+        {
+        #if defined(__SSE2__) || defined(_M_X64)
+            ui32 offset = 0;
+            for(; offset + 16 <= size; offset += 16)
+            {
+                const __m128i leftBytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(left + offset));
+                const __m128i rightBytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(right + offset));
+                if(_mm_movemask_epi8(_mm_cmpeq_epi8(leftBytes, rightBytes)) != 0xFFFF)
+                    return false;
+            }
+
+            return std::memcmp(left + offset, right + offset, size - offset) == 0;
+        #else
+            return std::memcmp(left, right, size) == 0;
+        #endif
+        }
+
+        //Writes a shadowed value to the program in use. Bools are written as integers, GL treats nonzero as true.
+        void issueUniformValue(GLint location, GLenum type, const ui8* value) noexcept
+        {
+            const auto* floatValue = reinterpret_cast<const GLfloat*>(value);
+            const auto* intValue = reinterpret_cast<const GLint*>(value);
+
+            switch(type)
+            {
+                case GL_FLOAT:
+                    glUniform1fv(location, 1, floatValue);
+                    break;
+                case GL_FLOAT_VEC2:
+                    glUniform2fv(location, 1, floatValue);
+                    break;
+                case GL_FLOAT_VEC3:
+                    glUniform3fv(location, 1, floatValue);
+                    break;
+                case GL_FLOAT_VEC4:
+                    glUniform4fv(location, 1, floatValue);
+                    break;
+                case GL_FLOAT_MAT3:
+                    glUniformMatrix3fv(location, 1, GL_FALSE, floatValue);
+                    break;
+                case GL_FLOAT_MAT4:
+                    glUniformMatrix4fv(location, 1, GL_FALSE, floatValue);
+                    break;
+                case GL_BOOL_VEC3:
+                    glUniform3iv(location, 1, intValue);
+                    break;
+                default:
+                    glUniform1iv(location, 1, intValue);
+                    break;
+            }
+        }
+
+        //glUniform*i/f also set bool uniforms, glUniform1i sets samplers.
+        bool isSetterTypeCompatible(GLenum uniformType, GLenum setterType) noexcept
+        {
+            switch(setterType)
+            {
+                case GL_INT:
+                    return uniformType == GL_INT || uniformType == GL_BOOL || isSamplerType(uniformType);
+                case GL_FLOAT:
+                    return uniformType == GL_FLOAT || uniformType == GL_BOOL;
+                case GL_FLOAT_VEC3:
+                    return uniformType == GL_FLOAT_VEC3 || uniformType == GL_BOOL_VEC3;
+                default:
+                    return uniformType == setterType;
+            }
+        }
+    }
+
+    Shader::Shader(Shader&& other) noexcept :
+        mUniformLocations(std::move(other.mUniformLocations)),
+        mUniformTypes(std::move(other.mUniformTypes)),
+        mUniformNames(std::move(other.mUniformNames)),
+        mUniformIndices(std::move(other.mUniformIndices)),
+        mUniformBlockBindings(std::move(other.mUniformBlockBindings)),
+        mActiveUniforms(std::move(other.mActiveUniforms)),
+        mActiveAttributes(std::move(other.mActiveAttributes)),
+        mActiveUniformBlocks(std::move(other.mActiveUniformBlocks)),
+        mUniformValues(std::move(other.mUniformValues)),
+        mUniformValueData(std::move(other.mUniformValueData)),
+        mIssuedUniformCount(other.mIssuedUniformCount),
+        mSkippedUniformCount(other.mSkippedUniformCount),
+        mIsCompiled(std::exchange(other.mIsCompiled, false)),
+        mProgramHandle(std::exchange(other.mProgramHandle, 0)),
+        mVertexShaderHandle(std::exchange(other.mVertexShaderHandle, 0)),
+        mFragmentShaderHandle(std::exchange(other.mFragmentShaderHandle, 0)),
+        mPendingBinaryCache(std::exchange(other.mPendingBinaryCache, nullptr)),
+        mPendingProgramKey(other.mPendingProgramKey)
+    {
+    }
+
+    Shader& Shader::operator=(Shader&& other) noexcept
+    {
+        if(this != &other)
+        {
+            release();
+            mUniformLocations = std::move(other.mUniformLocations);
+            mUniformTypes = std::move(other.mUniformTypes);
+            mUniformNames = std::move(other.mUniformNames);
+            mUniformIndices = std::move(other.mUniformIndices);
+            mUniformBlockBindings = std::move(other.mUniformBlockBindings);
+            mActiveUniforms = std::move(other.mActiveUniforms);
+            mActiveAttributes = std::move(other.mActiveAttributes);
+            mActiveUniformBlocks = std::move(other.mActiveUniformBlocks);
+            mUniformValues = std::move(other.mUniformValues);
+            mUniformValueData = std::move(other.mUniformValueData);
+            mIssuedUniformCount = other.mIssuedUniformCount;
+            mSkippedUniformCount = other.mSkippedUniformCount;
+            mIsCompiled = std::exchange(other.mIsCompiled, false);
+            mProgramHandle = std::exchange(other.mProgramHandle, 0);
+            mVertexShaderHandle = std::exchange(other.mVertexShaderHandle, 0);
+            mFragmentShaderHandle = std::exchange(other.mFragmentShaderHandle, 0);
+            mPendingBinaryCache = std::exchange(other.mPendingBinaryCache, nullptr);
+            mPendingProgramKey = other.mPendingProgramKey;
+        }
+
+        return *this;
+    }
+
     Shader::~Shader(void)
     {
-        glUseProgram(0);
-        glDeleteShader(mVertexShaderHandle);
-        glDeleteShader(mFragmentShaderHandle);
-        glDeleteProgram(mProgramHandle);
+        release();
+    }
+
+    void Shader::release(void)
+    {
+        auto& deletionQueue = DeletionQueue::getCurrent();
+        deletionQueue.release(GLObjectType::Shader, mVertexShaderHandle);
+        deletionQueue.release(GLObjectType::Shader, mFragmentShaderHandle);
+        deletionQueue.release(GLObjectType::Program, mProgramHandle);
+        mVertexShaderHandle = 0;
+        mFragmentShaderHandle = 0;
         mProgramHandle = 0;
     }
 
+    void Shader::adoptProgram(Shader&& other)
+    {
+        assert(this != &other && other.mIsCompiled);
+
+        //The values written to the old program, the new one starts at the defaults of its source.
+        struct ShadowedValue
+        {
+            std::string         name;
+            GLenum              type;
+            std::vector<ui8>    value;
+        };
+
+        std::vector<ShadowedValue> shadowedValues;
+        for(const auto& uniform : mActiveUniforms)
+        {
+            if(uniform.location < 0 || static_cast<ui32>(uniform.location) >= mUniformValues.size())
+                continue;
+
+            const auto& uniformValue = mUniformValues[uniform.location];
+            if(!uniformValue.isSet || uniformValue.size == 0)
+                continue;
+
+            const ui8* value = &mUniformValueData[uniformValue.offset];
+            shadowedValues.push_back({uniform.name, uniform.type, std::vector<ui8>(value, value + uniformValue.size)});
+        }
+
+        release();
+        mIsCompiled = std::exchange(other.mIsCompiled, false);
+        mProgramHandle = std::exchange(other.mProgramHandle, 0);
+        mVertexShaderHandle = std::exchange(other.mVertexShaderHandle, 0);
+        mFragmentShaderHandle = std::exchange(other.mFragmentShaderHandle, 0);
+        resolveUniforms();
+
+        if(shadowedValues.empty())
+            return;
+
+        //Uniforms that are still active with the same type get their values back.
+        use();
+        for(const auto& shadowedValue : shadowedValues)
+        {
+            const auto* variable = findUniform(shadowedValue.name);
+            if(variable == nullptr || variable->type != shadowedValue.type)
+                continue;
+
+            const auto size = static_cast<ui32>(shadowedValue.value.size());
+            if(updateUniformValue(variable->location, shadowedValue.value.data(), size))
+                issueUniformValue(variable->location, variable->type, shadowedValue.value.data());
+        }
+    }
+
     void Shader::link(void)
     {
         assert(mProgramHandle != 0);
 
-        i32 status;
         glLinkProgram(mProgramHandle);
-        glGetProgramiv(mProgramHandle, GL_LINK_STATUS, &status);
+        checkLinkStatus();
+        resolveUniforms();
+    }
 
-        if (status == 0)
-           THROW_RS_EXCEPTION("(Shader::link) : link() failed.", RSErrorCode::BGL_ShaderLinkFailed);
+    void Shader::reflect(void)
+    {
+        mActiveUniforms.clear();
+        mActiveAttributes.clear();
+        mActiveUniformBlocks.clear();
+        mReportedUniforms.clear();
+
+        GLint maxNameLength{0};
+        GLint count{0};
+        std::vector<GLchar> name;
+
+        glGetProgramiv(mProgramHandle, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxNameLength);
+        glGetProgramiv(mProgramHandle, GL_ACTIVE_UNIFORMS, &count);
+        name.resize(std::max(maxNameLength, 1));
+        for(GLuint index = 0; index < static_cast<GLuint>(count); ++index)
+        {
+            //Members of uniform blocks have no location.
+            GLint blockIndex{-1};
+            glGetActiveUniformsiv(mProgramHandle, 1, &index, GL_UNIFORM_BLOCK_INDEX, &blockIndex);
+            if(blockIndex != -1)
+                continue;
+
+            GLint size{0};
+            GLenum type{0};
+            glGetActiveUniform(mProgramHandle, index, static_cast<GLsizei>(name.size()), nullptr, &size, &type, name.data());
+
+            std::string uniformName(name.data());
+            const bool isArray = uniformName.size() > 3 && uniformName.compare(uniformName.size() - 3, 3, "[0]") == 0;
+            if(isArray)
+                uniformName.resize(uniformName.size() - 3);
+
+            mActiveUniforms.push_back({uniformName, glGetUniformLocation(mProgramHandle, name.data()), type, size});
+
+            //Array elements are not guaranteed to have consecutive locations.
+            for(GLint element = 1; isArray && element < size; ++element)
+            {
+                const std::string elementName = uniformName + "[" + std::to_string(element) + "]";
+                mActiveUniforms.push_back({elementName, glGetUniformLocation(mProgramHandle, elementName.c_str()), type, size - element});
+            }
+        }
+
+        glGetProgramiv(mProgramHandle, GL_ACTIVE_ATTRIBUTE_MAX_LENGTH, &maxNameLength);
+        glGetProgramiv(mProgramHandle, GL_ACTIVE_ATTRIBUTES, &count);
+        name.resize(std::max(maxNameLength, 1));
+        for(GLuint index = 0; index < static_cast<GLuint>(count); ++index)
+        {
+            GLint size{0};
+            GLenum type{0};
+            glGetActiveAttrib(mProgramHandle, index, static_cast<GLsizei>(name.size()), nullptr, &size, &type, name.data());
+            mActiveAttributes.push_back({name.data(), glGetAttribLocation(mProgramHandle, name.data()), type, size});
+        }
+
+        glGetProgramiv(mProgramHandle, GL_ACTIVE_UNIFORM_BLOCK_MAX_NAME_LENGTH, &maxNameLength);
+        glGetProgramiv(mProgramHandle, GL_ACTIVE_UNIFORM_BLOCKS, &count);
+        name.resize(std::max(maxNameLength, 1));
+        for(GLuint index = 0; index < static_cast<GLuint>(count); ++index)
+        {
+            GLint dataSize{0};
+            glGetActiveUniformBlockName(mProgramHandle, index, static_cast<GLsizei>(name.size()), nullptr, name.data());
+            glGetActiveUniformBlockiv(mProgramHandle, index, GL_UNIFORM_BLOCK_DATA_SIZE, &dataSize);
+            mActiveUniformBlocks.push_back({name.data(), index, dataSize});
+        }
+
+        //Uniforms are initialized by the link, but the shadow starts unset: binaries restored
+        //from the cache and relinked programs are not known to hold the defaults.
+        GLint maxLocation{-1};
+        for(const auto& uniform : mActiveUniforms)
+            maxLocation = std::max(maxLocation, uniform.location);
+
+        mUniformValues.assign(maxLocation + 1, UniformValue{0, 0, false});
+        mUniformValueData.clear();
+        for(const auto& uniform : mActiveUniforms)
+        {
+            if(uniform.location < 0)
+                continue;
+
+            const ui32 size = getUniformValueSize(uniform.type);
+            mUniformValues[uniform.location] = UniformValue{static_cast<ui32>(mUniformValueData.size()), size, false};
+            mUniformValueData.resize(mUniformValueData.size() + size);
+        }
+
+        const auto byName = [](const auto& left, const auto& right) { return left.name < right.name; };
+        std::sort(mActiveUniforms.begin(), mActiveUniforms.end(), byName);
+        std::sort(mActiveAttributes.begin(), mActiveAttributes.end(), byName);
+        std::sort(mActiveUniformBlocks.begin(), mActiveUniformBlocks.end(), byName);
+    }
+
+    void Shader::resolveUniforms(void)
+    {
+        reflect();
+
+        for(ui32 index = 0; index < mUniformNames.size(); ++index)
+        {
+            const auto* variable = findUniform(mUniformNames[index]);
+            mUniformLocations[index] = variable ? variable->location : -1;
+            mUniformTypes[index] = variable ? variable->type : 0;
+        }
+
+        for(const auto& [uniformBlock, bindingPoint] : mUniformBlockBindings)
+        {
+            if(const auto* block = findUniformBlock(uniformBlock))
+                glUniformBlockBinding(mProgramHandle, block->index, bindingPoint);
+        }
+    }
+
+    const ShaderVariable* Shader::findUniform(const std::string_view& name) const
+    {
+        return findByName(mActiveUniforms, name);
+    }
+
+    const ShaderVariable* Shader::findAttribute(const std::string_view& name) const
+    {
+        return findByName(mActiveAttributes, name);
+    }
+
+    const ShaderUniformBlock* Shader::findUniformBlock(const std::string_view& name) const
+    {
+        return findByName(mActiveUniformBlocks, name);
+    }
+
+    bool Shader::updateUniformValue(GLint location, const void* value, ui32 size, GLsizei count, bool isTransposed)
+    {
+        //glUniform* ignores -1.
+        if(location < 0)
+            return false;
+
+        //Array elements have consecutive locations, only the written ones are forgotten.
+        if(count != 1 || isTransposed)
+        {
+            const auto end = std::min<size_t>(static_cast<size_t>(location) + std::max<GLsizei>(count, 1), mUniformValues.size());
+            for(size_t index = location; index < end; ++index)
+                mUniformValues[index].isSet = false;
+
+            ++mIssuedUniformCount;
+            return true;
+        }
+
+        if(static_cast<ui32>(location) >= mUniformValues.size() || mUniformValues[location].size != size)
+        {
+            ++mIssuedUniformCount;
+            return true;
+        }
+
+        auto& uniformValue = mUniformValues[location];
+        ui8* shadow = &mUniformValueData[uniformValue.offset];
+        if(uniformValue.isSet && isEqual(shadow, static_cast<const ui8*>(value), size))
+        {
+            ++mSkippedUniformCount;
+            return false;
+        }
+
+        std::memcpy(shadow, value, size);
+        uniformValue.isSet = true;
+        ++mIssuedUniformCount;
+        return true;
+    }
+
+    void Shader::setUniform(GLint location, GLenum type, const void* value, GLsizei count)
+    {
+        const auto* floatValue = static_cast<const GLfloat*>(value);
+
+        switch(type)
+        {
+            case GL_FLOAT:
+                if(updateUniformValue(location, value, sizeof(GLfloat), count))
+                    glUniform1fv(location, count, floatValue);
+                break;
+            case GL_FLOAT_VEC2:
+                if(updateUniformValue(location, value, sizeof(GLfloat) * 2, count))
+                    glUniform2fv(location, count, floatValue);
+                break;
+            case GL_FLOAT_VEC3:
+                if(updateUniformValue(location, value, sizeof(GLfloat) * 3, count))
+                    glUniform3fv(location, count, floatValue);
+                break;
+            case GL_FLOAT_VEC4:
+                if(updateUniformValue(location, value, sizeof(GLfloat) * 4, count))
+                    glUniform4fv(location, count, floatValue);
+                break;
+            case GL_INT:
+                if(updateUniformValue(location, value, sizeof(GLint), count))
+                    glUniform1iv(location, count, static_cast<const GLint*>(value));
+                break;
+            case GL_FLOAT_MAT3:
+                if(updateUniformValue(location, value, sizeof(GLfloat) * 9, count))
+                    glUniformMatrix3fv(location, count, GL_FALSE, floatValue);
+                break;
+            case GL_FLOAT_MAT4:
+                if(updateUniformValue(location, value, sizeof(GLfloat) * 16, count))
+                    glUniformMatrix4fv(location, count, GL_FALSE, floatValue);
+                break;
+            default:
+                assert(0 && "Unsupported uniform type.");
+                break;
+        }
+    }
+
+    void Shader::invalidateUniformValues(void)
+    {
+        for(auto& uniformValue : mUniformValues)
+            uniformValue.isSet = false;
+    }
+
+    bool Shader::isUniformTypeCompatible(ui32 index, GLenum setterType) const noexcept
+    {
+        if(index >= mUniformTypes.size() || mUniformTypes[index] == 0)
+            return true;
+
+        return isSetterTypeCompatible(mUniformTypes[index], setterType);
+    }
+
+    GLint Shader::findUniformLocation(const std::string& uniform, GLenum setterType) const
+    {
+        const auto iterator = mUniformIndices.find(uniform);
+        if(iterator != mUniformIndices.end())
+        {
+            assert(isUniformTypeCompatible(iterator->second, setterType));
+            return mUniformLocations[iterator->second];
+        }
+
+        //Names that were not added are looked up in the reflection. A missing name is not an error, the
+        //uniform may be optimized out or removed by a define; the write goes to location -1 and is ignored.
+        const auto* variable = findUniform(uniform);
+        if(variable == nullptr)
+        {
+            reportMissingUniform(uniform);
+            return -1;
+        }
+
+        assert(isSetterTypeCompatible(variable->type, setterType));
+        return variable->location;
+    }
+
+    void Shader::reportMissingUniform(const std::string& uniform) const
+    {
+    #ifndef NDEBUG
+        if(std::find(mReportedUniforms.begin(), mReportedUniforms.end(), uniform) != mReportedUniforms.end())
+            return;
+
+        mReportedUniforms.push_back(uniform);
+        std::cerr << "Shader: the program has no active uniform \"" << uniform << "\", writes to it are ignored." << std::endl;
+    #else
+        (void)uniform;
+    #endif
+    }
+
+    bool Shader::bindUniformBlock(const std::string& uniformBlock, ui32 bindingPoint)
+    {
+        assert(mProgramHandle != 0);
+
+        const auto* block = findUniformBlock(uniformBlock);
+        if(!block)
+            return false;
+
+        glUniformBlockBinding(mProgramHandle, block->index, bindingPoint);
+
+        const auto binding = std::find_if(mUniformBlockBindings.begin(), mUniformBlockBindings.end(),
+                                          [&uniformBlock](const auto& entry) { return entry.first == uniformBlock; });
+        if(binding != mUniformBlockBindings.end())
+            binding->second = bindingPoint;
+        else
+            mUniformBlockBindings.emplace_back(uniformBlock, bindingPoint);
+
+        return true;
     }
 
     void Shader::loadFile(const std::string_view& fileAddress, std::string* outString)
@@ -66,31 +586,102 @@ namespace RS::Graphics::BaseGL
             THROW_RS_EXCEPTION("(Shader::loadFile) : Shader file could not be loaded.", RSErrorCode::BGL_ShaderFileLoadingFailed);
     }
 
-    void Shader::loadCompileAndLink(const std::string_view& vertexShaderFile, const std::string_view& fragmentShaderFile)
+    void Shader::loadCompileAndLink(const std::string_view& vertexShaderFile, const std::string_view& fragmentShaderFile,
+                                    ProgramBinaryCache* programBinaryCache)
     {
-        mIsCompiled = false;
-
         std::string vertexShaderCode;
         std::string fragmentShaderCode;
 
         loadFile(vertexShaderFile, &vertexShaderCode);
         loadFile(fragmentShaderFile, &fragmentShaderCode);
 
+        compileAndLink(vertexShaderCode, fragmentShaderCode, programBinaryCache);
+    }
+
+    void Shader::compileAndLink(const std::string_view& vertexShaderCode, const std::string_view& fragmentShaderCode,
+                                ProgramBinaryCache* programBinaryCache)
+    {
+        beginCompileAndLink(vertexShaderCode, fragmentShaderCode, programBinaryCache);
+        finishCompileAndLink();
+    }
+
+    void Shader::beginCompileAndLink(const std::string_view& vertexShaderCode, const std::string_view& fragmentShaderCode,
+                                     ProgramBinaryCache* programBinaryCache)
+    {
+        mIsCompiled = false;
+        mPendingBinaryCache = nullptr;
+
+        release();
         mProgramHandle = glCreateProgram();
         if(mProgramHandle == 0)
-           THROW_RS_EXCEPTION("(Shader::loadCompileAndLink) : glCreateProgram().", RSErrorCode::BGL_CreatingShaderProgramFailed);
+           THROW_RS_EXCEPTION("(Shader::beginCompileAndLink) : glCreateProgram().", RSErrorCode::BGL_CreatingShaderProgramFailed);
+
+        if(programBinaryCache && programBinaryCache->isEnabled())
+        {
+            //The stage markers keep "a" + "bc" and "ab" + "c" apart.
+            ui64 sourcesHash = ProgramBinaryCache::hash("vertex:");
+            sourcesHash = ProgramBinaryCache::hash(vertexShaderCode, sourcesHash);
+            sourcesHash = ProgramBinaryCache::hash("fragment:", sourcesHash);
+            sourcesHash = ProgramBinaryCache::hash(fragmentShaderCode, sourcesHash);
+            const ui64 programKey = programBinaryCache->getKey(sourcesHash);
+
+            if(programBinaryCache->load(programKey, mProgramHandle))
+            {
+                resolveUniforms();
+                mIsCompiled = true;
+                return;
+            }
 
+            programBinaryCache->prepare(mProgramHandle);
+            mPendingBinaryCache = programBinaryCache;
+            mPendingProgramKey = programKey;
+        }
+
+        //No status is queried here, so the driver can compile and link in the background.
         mVertexShaderHandle = compileShader(vertexShaderCode, GL_VERTEX_SHADER);
         mFragmentShaderHandle = compileShader(fragmentShaderCode, GL_FRAGMENT_SHADER);        
 
         glAttachShader(mProgramHandle, mVertexShaderHandle);
         glAttachShader(mProgramHandle, mFragmentShaderHandle);
 
-        link();
-        
+        glLinkProgram(mProgramHandle);
+    }
+
+    bool Shader::isBuildComplete(void)
+    {
+        if(mIsCompiled || mProgramHandle == 0 || !isParallelCompileSupported())
+            return true;
+
+        GLint isComplete{GL_FALSE};
+        glGetProgramiv(mProgramHandle, GL_COMPLETION_STATUS_KHR, &isComplete);
+
+        return isComplete == GL_TRUE;
+    }
+
+    void Shader::finishCompileAndLink(void)
+    {
+        assert(mProgramHandle != 0);
+
+        if(mIsCompiled)
+            return;
+
+        checkCompileStatus(mVertexShaderHandle);
+        checkCompileStatus(mFragmentShaderHandle);
+        checkLinkStatus();
+        resolveUniforms();
+
+        if(mPendingBinaryCache)
+            mPendingBinaryCache->store(mPendingProgramKey, mProgramHandle);
+        mPendingBinaryCache = nullptr;
+
         mIsCompiled = true;
     }
 
+    bool Shader::isParallelCompileSupported(void)
+    {
+        return GLEW_KHR_parallel_shader_compile || GLEW_ARB_parallel_shader_compile;
+    }
+
     ui32 Shader::compileShader(const std::string_view& shaderCode, ui32 shaderType)
     {
         const ui32 shaderHandle = glCreateShader(shaderType);
@@ -98,11 +689,16 @@ namespace RS::Graphics::BaseGL
         if(shaderHandle == 0)
             THROW_RS_EXCEPTION("(Shader::compileShader) : glCreateShader() failed.", RSErrorCode::BGL_CreatingShaderFailed);
 
-        const char* cShaderCode = &shaderCode[0];
-        glShaderSource(shaderHandle, 1, &cShaderCode, NULL);
-        //glShaderSource(shaderHandle, 1, (const char**)shaderCode[0], NULL);
+        const char* cShaderCode = shaderCode.data();
+        const GLint shaderCodeLength = static_cast<GLint>(shaderCode.size());
+        glShaderSource(shaderHandle, 1, &cShaderCode, &shaderCodeLength);
         glCompileShader(shaderHandle);
 
+        return shaderHandle;
+    }
+
+    void Shader::checkCompileStatus(ui32 shaderHandle)
+    {
         i32 status;
         glGetShaderiv(shaderHandle, GL_COMPILE_STATUS, &status);
 
@@ -112,32 +708,61 @@ namespace RS::Graphics::BaseGL
             glGetShaderiv(shaderHandle, GL_INFO_LOG_LENGTH, &infoLength);
             if (infoLength)
             {
-                //TODO: use normal string?!.
-                auto infoBuffer = new char[infoLength];
-
-                glGetShaderInfoLog(shaderHandle, infoLength, NULL, infoBuffer);
-                const std::string errorMessage(infoBuffer);
-                
-                delete infoBuffer;
-                infoBuffer = 0;
+                std::string errorMessage(infoLength, '\0');
+                glGetShaderInfoLog(shaderHandle, infoLength, NULL, errorMessage.data());
+                errorMessage.resize(errorMessage.find('\0'));
                 
                 THROW_RS_EXCEPTION("(Shader::compileShader) : Could not compile shader. " + errorMessage, RSErrorCode::BGL_CompilingShaderFailed);  
             }
-            glDeleteShader(shaderHandle);
 
             THROW_RS_EXCEPTION("(Shader::compileShader) : Could not compile shader.", RSErrorCode::BGL_CompilingShaderFailed);  
         }
+    }
 
-        return shaderHandle;
+    void Shader::checkLinkStatus(void)
+    {
+        i32 status;
+        glGetProgramiv(mProgramHandle, GL_LINK_STATUS, &status);
+
+        if (status == 0)
+        {
+            i32 infoLength = 0;
+            glGetProgramiv(mProgramHandle, GL_INFO_LOG_LENGTH, &infoLength);
+            std::string errorMessage(infoLength, '\0');
+            if (infoLength)
+            {
+                glGetProgramInfoLog(mProgramHandle, infoLength, NULL, errorMessage.data());
+                errorMessage.resize(errorMessage.find('\0'));
+            }
+
+            THROW_RS_EXCEPTION("(Shader::link) : link() failed. " + errorMessage, RSErrorCode::BGL_ShaderLinkFailed);
+        }
     }
 
-    RSErrorCode Shader::addUniform(const std::string& uniform)
+    UniformHandle Shader::addUniform(const std::string& uniform)
     {
         if(mProgramHandle == 0)
-            return RSErrorCode::BGL_ShaderAddUniformFailed;
+            return UniformHandle();
 
-        uniformLocationsList[uniform] = glGetUniformLocation(mProgramHandle, uniform.c_str());
-        
-        return  RSErrorCode::Done;
+        if(const auto iterator = mUniformIndices.find(uniform); iterator != mUniformIndices.end())
+            return UniformHandle{iterator->second};
+
+        const ui32 index = static_cast<ui32>(mUniformLocations.size());
+        const auto* variable = findUniform(uniform);
+        if(variable == nullptr)
+            reportMissingUniform(uniform);
+
+        mUniformLocations.push_back(variable ? variable->location : -1);
+        mUniformTypes.push_back(variable ? variable->type : 0);
+        mUniformNames.push_back(uniform);
+        mUniformIndices.emplace(uniform, index);
+
+        return UniformHandle{index};
+    }
+
+    UniformHandle Shader::getUniformHandle(const std::string& uniform) const
+    {
+        const auto iterator = mUniformIndices.find(uniform);
+        return iterator != mUniformIndices.end() ? UniformHandle{iterator->second} : UniformHandle();
     }
 }
\ No newline at end of file
@@ -0,0 +1,334 @@
+/*
+BSD 2-Clause License
+Copyright (c) 2017, Davood Rasti and Alireza Rasti - rastisoft
+All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "RS/Graphics/BaseGL/ShaderHotReloader.h"
+#include "RS/Exception/RSException.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <unordered_map>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+using namespace RS::Exception;
+
+namespace RS::Graphics::BaseGL
+{
+    namespace
+    {
+        //How often the watcher thread checks whether it should stop.(in millisec)
+        constexpr i32 stopCheckInterval{100};
+
+        bool readFile(const std::string& fileAddress, std::string* outString)
+        {
+            std::ifstream inStream(fileAddress, std::ios::in);
+            if(!inStream.is_open())
+                return false;
+
+            std::stringstream stringStream;
+            stringStream << inStream.rdbuf();
+            *outString = stringStream.str();
+            return true;
+        }
+
+        std::string getCanonicalPath(const std::string& file)
+        {
+            std::error_code errorCode;
+            const auto path = std::filesystem::weakly_canonical(file, errorCode);
+            return errorCode ? file : path.string();
+        }
+
+        //The canonical paths of the files a program is built from.
+        std::vector<std::string> getProgramFiles(const std::string& vertexShaderFile, const std::string& fragmentShaderFile,
+                                                 ShaderPreprocessor* preprocessor)
+        {
+            if(preprocessor == nullptr)
+                return {getCanonicalPath(vertexShaderFile), getCanonicalPath(fragmentShaderFile)};
+
+            std::vector<std::string> files = preprocessor->getFiles(vertexShaderFile);
+            for(const auto& file : preprocessor->getFiles(fragmentShaderFile))
+            {
+                if(std::find(files.begin(), files.end(), file) == files.end())
+                    files.push_back(file);
+            }
+
+            return files;
+        }
+    }
+
+    ShaderHotReloader::~ShaderHotReloader(void)
+    {
+        stop();
+    }
+
+    void ShaderHotReloader::watch(Shader& shader, const std::string& vertexShaderFile, const std::string& fragmentShaderFile,
+                                  ShaderPreprocessor* preprocessor, std::vector<std::string> defines)
+    {
+        auto files = getProgramFiles(vertexShaderFile, fragmentShaderFile, preprocessor);
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        mWatchedPrograms.push_back({&shader, vertexShaderFile, fragmentShaderFile, preprocessor, std::move(defines), std::move(files)});
+    }
+
+    void ShaderHotReloader::unwatch(Shader& shader)
+    {
+        const auto isOfShader = [&shader](const auto& entry) { return entry.shader == &shader; };
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mWatchedPrograms.erase(std::remove_if(mWatchedPrograms.begin(), mWatchedPrograms.end(), isOfShader), mWatchedPrograms.end());
+            mPendingSources.erase(std::remove_if(mPendingSources.begin(), mPendingSources.end(), isOfShader), mPendingSources.end());
+        }
+
+        //The builds belong to the context thread and are not guarded by mMutex.
+        mPendingBuilds.erase(std::remove_if(mPendingBuilds.begin(), mPendingBuilds.end(), isOfShader), mPendingBuilds.end());
+    }
+
+    void ShaderHotReloader::start(void)
+    {
+    #ifdef __linux__
+        if(mIsRunning)
+            return;
+
+        mIsRunning = true;
+        mWatcherThread = std::thread(&ShaderHotReloader::watcherLoop, this);
+    #endif
+    }
+
+    void ShaderHotReloader::stop(void)
+    {
+        mIsRunning = false;
+        if(mWatcherThread.joinable())
+            mWatcherThread.join();
+    }
+
+    void ShaderHotReloader::requestReload(Shader& shader)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        for(const auto& program : mWatchedPrograms)
+        {
+            if(program.shader != &shader)
+                continue;
+
+            for(const auto& file : program.files)
+                queueProgram(program, file);
+        }
+    }
+
+    void ShaderHotReloader::queueSources(const std::string& file)
+    {
+        for(const auto& program : mWatchedPrograms)
+        {
+            if(std::find(program.files.begin(), program.files.end(), file) != program.files.end())
+                queueProgram(program, file);
+        }
+    }
+
+    void ShaderHotReloader::queueProgram(const WatchedProgram& program, const std::string& file)
+    {
+        const auto pending = std::find_if(mPendingSources.begin(), mPendingSources.end(),
+                                          [&program](const auto& entry) { return entry.shader == program.shader; });
+
+        //The preprocessor is not thread safe, the files are expanded by update() on the context thread.
+        if(program.preprocessor != nullptr)
+        {
+            if(pending != mPendingSources.end())
+                pending->changedFiles.push_back(file);
+            else
+                mPendingSources.push_back({program.shader, "", "", program.preprocessor, program.defines,
+                                           program.vertexShaderFile, program.fragmentShaderFile, {file}});
+            return;
+        }
+
+        PendingSources sources{program.shader, "", "", nullptr, {}, program.vertexShaderFile, program.fragmentShaderFile, {}};
+        if(!readFile(program.vertexShaderFile, &sources.vertexShaderCode) ||
+           !readFile(program.fragmentShaderFile, &sources.fragmentShaderCode))
+            return;
+
+        //A newer change of the same program replaces the older one.
+        if(pending != mPendingSources.end())
+            *pending = std::move(sources);
+        else
+            mPendingSources.push_back(std::move(sources));
+    }
+
+    void ShaderHotReloader::watcherLoop(void)
+    {
+    #ifdef __linux__
+        const i32 inotifyHandle = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if(inotifyHandle < 0)
+        {
+            mIsRunning = false;
+            return;
+        }
+
+        //Directories are watched rather than files: editors often save by
+        //writing a new file and renaming it over the old one. The directories
+        //of includes added after start() are watched once the thread restarts.
+        std::unordered_map<i32, std::string> watchedDirectories;
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            for(const auto& program : mWatchedPrograms)
+            {
+                for(const auto& file : program.files)
+                {
+                    const std::string directory = std::filesystem::path(file).parent_path().string();
+                    const i32 watchHandle = inotify_add_watch(inotifyHandle, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+                    if(watchHandle >= 0)
+                        watchedDirectories[watchHandle] = directory;
+                }
+            }
+        }
+
+        alignas(inotify_event) char eventBuffer[4096];
+        while(mIsRunning)
+        {
+            pollfd pollDescriptor{inotifyHandle, POLLIN, 0};
+            if(::poll(&pollDescriptor, 1, stopCheckInterval) <= 0)
+                continue;
+
+            const ssize_t length = read(inotifyHandle, eventBuffer, sizeof(eventBuffer));
+            if(length <= 0)
+                continue;
+
+            std::lock_guard<std::mutex> lock(mMutex);
+            for(ssize_t offset = 0; offset < length;)
+            {
+                const auto event = reinterpret_cast<const inotify_event*>(eventBuffer + offset);
+                offset += sizeof(inotify_event) + event->len;
+
+                const auto directory = watchedDirectories.find(event->wd);
+                if(event->len == 0 || directory == watchedDirectories.end())
+                    continue;
+
+                queueSources((std::filesystem::path(directory->second) / event->name).string());
+            }
+        }
+
+        close(inotifyHandle);
+    #endif
+    }
+
+    void ShaderHotReloader::update(void)
+    {
+        //Builds started by the previous update() are finished first, so without parallel compile
+        //the driver gets at least one frame to work on them before finishCompileAndLink() blocks.
+        const bool isParallelCompileSupported = Shader::isParallelCompileSupported();
+        for(auto iterator = mPendingBuilds.begin(); iterator != mPendingBuilds.end();)
+        {
+            if(!iterator->newShader->isBuildComplete())
+            {
+                ++iterator;
+                continue;
+            }
+
+            if(!isParallelCompileSupported)
+                ++mBlockingBuildCount;
+
+            try
+            {
+                iterator->newShader->finishCompileAndLink();
+                iterator->shader->adoptProgram(std::move(*iterator->newShader));
+                reportReload(*iterator->shader, true, "");
+            }
+            catch(const RSException& exception)
+            {
+                reportReload(*iterator->shader, false, exception.what());
+            }
+
+            iterator = mPendingBuilds.erase(iterator);
+        }
+
+        std::vector<PendingSources> pendingSources;
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            pendingSources.swap(mPendingSources);
+        }
+
+        for(auto& sources : pendingSources)
+        {
+            if(sources.preprocessor != nullptr && !expandSources(sources))
+                continue;
+
+            //A build that is still running for the same program is superseded.
+            mPendingBuilds.erase(std::remove_if(mPendingBuilds.begin(), mPendingBuilds.end(),
+                                                [&sources](const auto& entry) { return entry.shader == sources.shader; }),
+                                 mPendingBuilds.end());
+
+            auto newShader = std::make_unique<Shader>();
+            try
+            {
+                newShader->beginCompileAndLink(sources.vertexShaderCode, sources.fragmentShaderCode);
+                mPendingBuilds.push_back({sources.shader, std::move(newShader)});
+            }
+            catch(const RSException& exception)
+            {
+                reportReload(*sources.shader, false, exception.what());
+            }
+        }
+    }
+
+    bool ShaderHotReloader::expandSources(PendingSources& sources)
+    {
+        for(const auto& file : sources.changedFiles)
+            sources.preprocessor->invalidate(file);
+
+        try
+        {
+            sources.vertexShaderCode = sources.preprocessor->expand(sources.vertexShaderFile, sources.defines);
+            sources.fragmentShaderCode = sources.preprocessor->expand(sources.fragmentShaderFile, sources.defines);
+            auto files = getProgramFiles(sources.vertexShaderFile, sources.fragmentShaderFile, sources.preprocessor);
+
+            //The includes may have changed with the edit.
+            std::lock_guard<std::mutex> lock(mMutex);
+            for(auto& program : mWatchedPrograms)
+            {
+                if(program.shader == sources.shader)
+                    program.files = std::move(files);
+            }
+        }
+        catch(const RSException& exception)
+        {
+            reportReload(*sources.shader, false, exception.what());
+            return false;
+        }
+
+        return true;
+    }
+
+    void ShaderHotReloader::reportReload(const Shader& shader, bool isSucceeded, const std::string& message)
+    {
+        if(isSucceeded)
+            ++mReloadCount;
+        else
+            ++mFailedReloadCount;
+
+        if(mReloadCallback)
+            mReloadCallback(shader, isSucceeded, message);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,194 @@
+/*
+BSD 2-Clause License
+Copyright (c) 2017, Davood Rasti and Alireza Rasti - rastisoft
+All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "RS/Graphics/BaseGL/ShaderLibrary.h"
+#include "RS/Exception/RSException.h"
+
+#include <cassert>
+#include <fstream>
+#include <sstream>
+
+using namespace std::chrono;
+using namespace RS::Exception;
+
+namespace RS::Graphics::BaseGL
+{
+    namespace
+    {
+        std::string readFile(const std::string& fileAddress)
+        {
+            std::ifstream inStream(fileAddress, std::ios::in);
+            if(!inStream.is_open())
+                THROW_RS_EXCEPTION("(ShaderLibrary::add) : Shader file could not be loaded. " + fileAddress, RSErrorCode::BGL_ShaderFileLoadingFailed);
+
+            std::stringstream stringStream;
+            stringStream << inStream.rdbuf();
+            return stringStream.str();
+        }
+
+        RS_INLINE f32 getMilliseconds(steady_clock::time_point begin, steady_clock::time_point end)
+        {
+            return duration<f32, std::milli>(end - begin).count();
+        }
+
+        const std::string emptyString;
+    }
+
+    ShaderLibrary::ShaderLibrary(ProgramBinaryCache* programBinaryCache) :
+        mProgramBinaryCache(programBinaryCache)
+    {
+    }
+
+    Shader& ShaderLibrary::add(const std::string& name, const std::string& vertexShaderFile, const std::string& fragmentShaderFile)
+    {
+        return addSource(name, readFile(vertexShaderFile), readFile(fragmentShaderFile));
+    }
+
+    Shader& ShaderLibrary::addSource(const std::string& name, std::string vertexShaderCode, std::string fragmentShaderCode)
+    {
+        assert(mProgramIndices.find(name) == mProgramIndices.end());
+
+        auto program = std::make_unique<ProgramEntry>();
+        program->name = name;
+        program->vertexShaderCode = std::move(vertexShaderCode);
+        program->fragmentShaderCode = std::move(fragmentShaderCode);
+        program->timing.name = name;
+
+        mProgramIndices.emplace(name, static_cast<ui32>(mPrograms.size()));
+        mPrograms.push_back(std::move(program));
+
+        return mPrograms.back()->shader;
+    }
+
+    void ShaderLibrary::submit(void)
+    {
+        //Lets the driver use as many compiler threads as it likes.
+        if(GLEW_KHR_parallel_shader_compile)
+            glMaxShaderCompilerThreadsKHR(0xFFFFFFFF);
+        else if(GLEW_ARB_parallel_shader_compile)
+            glMaxShaderCompilerThreadsARB(0xFFFFFFFF);
+
+        for(auto& program : mPrograms)
+        {
+            if(program->state != BuildState::Added)
+                continue;
+
+            program->submitStartTime = steady_clock::now();
+            program->state = BuildState::Submitted;
+
+            try
+            {
+                program->shader.beginCompileAndLink(program->vertexShaderCode, program->fragmentShaderCode, mProgramBinaryCache);
+            }
+            catch(const RSException& exception)
+            {
+                program->errorMessage = exception.what();
+                program->state = BuildState::Failed;
+                ++mFailedCount;
+                ++mFinishedCount;
+            }
+
+            program->timing.submitTime = getMilliseconds(program->submitStartTime, steady_clock::now());
+        }
+    }
+
+    void ShaderLibrary::finish(ProgramEntry& program)
+    {
+        try
+        {
+            program.shader.finishCompileAndLink();
+            program.state = BuildState::Succeeded;
+            program.timing.isSucceeded = true;
+        }
+        catch(const RSException& exception)
+        {
+            program.errorMessage = exception.what();
+            program.state = BuildState::Failed;
+            ++mFailedCount;
+        }
+
+        //The sources are not needed anymore.
+        program.vertexShaderCode = std::string();
+        program.fragmentShaderCode = std::string();
+        program.timing.buildTime = getMilliseconds(program.submitStartTime, steady_clock::now());
+        ++mFinishedCount;
+    }
+
+    bool ShaderLibrary::poll(f32 timeBudget)
+    {
+        const auto startTime = steady_clock::now();
+        bool isAllFinished{true};
+
+        for(auto& program : mPrograms)
+        {
+            if(program->state != BuildState::Submitted)
+                continue;
+
+            if(timeBudget > 0.0f && getMilliseconds(startTime, steady_clock::now()) >= timeBudget)
+                return false;
+
+            if(program->shader.isBuildComplete())
+                finish(*program);
+            else
+                isAllFinished = false;
+        }
+
+        return isAllFinished;
+    }
+
+    void ShaderLibrary::finishAll(void)
+    {
+        for(auto& program : mPrograms)
+        {
+            if(program->state == BuildState::Submitted)
+                finish(*program);
+        }
+    }
+
+    bool ShaderLibrary::isReady(const std::string& name) const
+    {
+        const auto iterator = mProgramIndices.find(name);
+        return iterator != mProgramIndices.end() && mPrograms[iterator->second]->state == BuildState::Succeeded;
+    }
+
+    Shader* ShaderLibrary::get(const std::string& name)
+    {
+        return isReady(name) ? &mPrograms[mProgramIndices.at(name)]->shader : nullptr;
+    }
+
+    const std::string& ShaderLibrary::getErrorMessage(const std::string& name) const
+    {
+        const auto iterator = mProgramIndices.find(name);
+        return iterator != mProgramIndices.end() ? mPrograms[iterator->second]->errorMessage : emptyString;
+    }
+
+    std::vector<ShaderBuildTiming> ShaderLibrary::getTimings(void) const
+    {
+        std::vector<ShaderBuildTiming> timings;
+        timings.reserve(mPrograms.size());
+        for(const auto& program : mPrograms)
+            timings.push_back(program->timing);
+
+        return timings;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,210 @@
+/*
+BSD 2-Clause License
+Copyright (c) 2017, Davood Rasti and Alireza Rasti - rastisoft
+All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "RS/Graphics/BaseGL/ShaderPreprocessor.h"
+#include "RS/Exception/RSException.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+using namespace RS::Exception;
+
+namespace RS::Graphics::BaseGL
+{
+    namespace
+    {
+        //Returns the file of an #include line, or an empty string for other lines.
+        std::string getIncludeFile(const std::string& line)
+        {
+            const auto begin = line.find_first_not_of(" \t");
+            if(begin == std::string::npos || line.compare(begin, 8, "#include") != 0)
+                return std::string();
+
+            const auto open = line.find_first_of("\"<", begin + 8);
+            if(open == std::string::npos)
+                return std::string();
+
+            const auto close = line.find(line[open] == '"' ? '"' : '>', open + 1);
+            if(close == std::string::npos)
+                return std::string();
+
+            return line.substr(open + 1, close - open - 1);
+        }
+
+        bool isVersionLine(const std::string& line)
+        {
+            const auto begin = line.find_first_not_of(" \t");
+            return begin != std::string::npos && line.compare(begin, 8, "#version") == 0;
+        }
+    }
+
+    std::string ShaderPreprocessor::findIncludeFile(const std::string& include, const std::string& includingFile) const
+    {
+        std::error_code errorCode;
+        const auto nextToFile = std::filesystem::path(includingFile).parent_path() / include;
+        if(std::filesystem::exists(nextToFile, errorCode))
+            return std::filesystem::weakly_canonical(nextToFile, errorCode).string();
+
+        for(const auto& directory : mIncludeDirectories)
+        {
+            const auto inDirectory = std::filesystem::path(directory) / include;
+            if(std::filesystem::exists(inDirectory, errorCode))
+                return std::filesystem::weakly_canonical(inDirectory, errorCode).string();
+        }
+
+        THROW_RS_EXCEPTION("(ShaderPreprocessor::load) : Include file could not be found. " + include + " in " + includingFile,
+                           RSErrorCode::BGL_ShaderIncludeFailed);
+    }
+
+    void ShaderPreprocessor::expandIncludes(const std::string& file, std::unordered_set<std::string>* includedFiles,
+                                            std::string* outSource) const
+    {
+        std::ifstream inStream(file, std::ios::in);
+        if(!inStream.is_open())
+            THROW_RS_EXCEPTION("(ShaderPreprocessor::load) : Shader file could not be loaded. " + file, RSErrorCode::BGL_ShaderFileLoadingFailed);
+
+        //Only the file given to load() is expanded with an empty set.
+        const bool isIncluded = !includedFiles->empty();
+        //Marked before its includes are expanded, so include cycles end here.
+        includedFiles->insert(file);
+
+        std::string line;
+        ui32 lineNumber = 0;
+        while(getline(inStream, line))
+        {
+            ++lineNumber;
+
+            const std::string include = getIncludeFile(line);
+            if(include.empty())
+            {
+                //#version is only allowed as the first directive of the source, it is commented out
+                //rather than removed so the line numbers stay right.
+                if(isIncluded && isVersionLine(line))
+                    *outSource += "//" + line + "\n";
+                else
+                    *outSource += line + "\n";
+                continue;
+            }
+
+            const std::string includeFile = findIncludeFile(include, file);
+            if(includedFiles->count(includeFile) == 0)
+            {
+                *outSource += "#line 1\n";
+                expandIncludes(includeFile, includedFiles, outSource);
+            }
+
+            *outSource += "#line " + std::to_string(lineNumber + 1) + "\n";
+        }
+    }
+
+    const std::string& ShaderPreprocessor::load(const std::string& file)
+    {
+        if(const auto iterator = mLoadedFiles.find(file); iterator != mLoadedFiles.end())
+            return iterator->second.source;
+
+        std::error_code errorCode;
+        const std::string path = std::filesystem::weakly_canonical(file, errorCode).string();
+
+        std::unordered_set<std::string> includedFiles;
+        LoadedFile loadedFile;
+        expandIncludes(errorCode ? file : path, &includedFiles, &loadedFile.source);
+        loadedFile.files.assign(includedFiles.begin(), includedFiles.end());
+
+        return mLoadedFiles.emplace(file, std::move(loadedFile)).first->second.source;
+    }
+
+    const std::vector<std::string>& ShaderPreprocessor::getFiles(const std::string& file)
+    {
+        load(file);
+        return mLoadedFiles.find(file)->second.files;
+    }
+
+    void ShaderPreprocessor::invalidate(const std::string& changedFile)
+    {
+        for(auto iterator = mLoadedFiles.begin(); iterator != mLoadedFiles.end();)
+        {
+            const auto& files = iterator->second.files;
+            if(std::find(files.begin(), files.end(), changedFile) == files.end())
+            {
+                ++iterator;
+                continue;
+            }
+
+            //Expanded keys are the path followed by "\n" and the defines.
+            const std::string& file = iterator->first;
+            for(auto expanded = mExpandedSources.begin(); expanded != mExpandedSources.end();)
+            {
+                const std::string& key = expanded->first;
+                if(key.compare(0, file.size(), file) == 0 && (key.size() == file.size() || key[file.size()] == '\n'))
+                    expanded = mExpandedSources.erase(expanded);
+                else
+                    ++expanded;
+            }
+
+            iterator = mLoadedFiles.erase(iterator);
+        }
+    }
+
+    const std::string& ShaderPreprocessor::expand(const std::string& file, const std::vector<std::string>& defines)
+    {
+        std::string key = file;
+        for(const auto& define : defines)
+            key += "\n" + define;
+
+        if(const auto iterator = mExpandedSources.find(key); iterator != mExpandedSources.end())
+            return iterator->second;
+
+        return mExpandedSources.emplace(std::move(key), injectDefines(load(file), defines)).first->second;
+    }
+
+    std::string ShaderPreprocessor::injectDefines(const std::string& source, const std::vector<std::string>& defines)
+    {
+        if(defines.empty())
+            return source;
+
+        std::string defineLines;
+        for(const auto& define : defines)
+            defineLines += "#define " + define + "\n";
+
+        //#version must stay the first directive, the defines go right after it.
+        std::istringstream stream(source);
+        std::string line;
+        ui32 lineNumber = 0;
+        size_t offset = 0;
+        while(getline(stream, line))
+        {
+            ++lineNumber;
+            offset += line.size() + 1;
+            if(isVersionLine(line))
+            {
+                offset = std::min(offset, source.size());
+                return source.substr(0, offset) + (source[offset - 1] == '\n' ? "" : "\n") + defineLines +
+                       "#line " + std::to_string(lineNumber + 1) + "\n" + source.substr(offset);
+            }
+        }
+
+        return defineLines + "#line 1\n" + source;
+    }
+}
\ No newline at end of file
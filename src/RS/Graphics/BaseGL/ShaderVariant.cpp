@@ -0,0 +1,215 @@
+/*
+BSD 2-Clause License
+Copyright (c) 2017, Davood Rasti and Alireza Rasti - rastisoft
+All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "RS/Graphics/BaseGL/ShaderVariant.h"
+#include "RS/Exception/RSException.h"
+
+#include <cassert>
+#include <cctype>
+#include <exception>
+#include <fstream>
+#include <sstream>
+
+using namespace RS::Exception;
+
+namespace RS::Graphics::BaseGL
+{
+    namespace
+    {
+        //The name of a "NAME VALUE" define.
+        std::string getDefineName(const std::string& define)
+        {
+            return define.substr(0, define.find_first_of(" \t"));
+        }
+
+        //Whether name appears in source as a whole identifier.
+        bool isNameUsed(const std::string& source, const std::string& name)
+        {
+            const auto isIdentifierCharacter = [](char character) { return std::isalnum(static_cast<unsigned char>(character)) || character == '_'; };
+            for(auto position = source.find(name); position != std::string::npos; position = source.find(name, position + 1))
+            {
+                const size_t end = position + name.size();
+                if((position == 0 || !isIdentifierCharacter(source[position - 1])) &&
+                   (end == source.size() || !isIdentifierCharacter(source[end])))
+                    return true;
+            }
+
+            return false;
+        }
+    }
+
+    ShaderVariant::ShaderVariant(ShaderPreprocessor& preprocessor, const std::string& vertexShaderFile,
+                                 const std::string& fragmentShaderFile, std::vector<std::string> defines,
+                                 ProgramBinaryCache* programBinaryCache) :
+        mPreprocessor(preprocessor)
+        ,mVertexShaderFile(vertexShaderFile)
+        ,mFragmentShaderFile(fragmentShaderFile)
+        ,mDefines(std::move(defines))
+        ,mProgramBinaryCache(programBinaryCache)
+    {
+        assert(mDefines.size() <= 64);
+    }
+
+    ShaderVariant::ProgramEntry& ShaderVariant::findOrAddProgram(ui64 mask, bool* isAdded)
+    {
+        *isAdded = false;
+        if(const auto iterator = mVariants.find(mask); iterator != mVariants.end())
+            return *iterator->second;
+
+        //Defines the sources do not mention are left out, so their variants end up with the same sources.
+        const std::string& vertexShaderSource = mPreprocessor.load(mVertexShaderFile);
+        const std::string& fragmentShaderSource = mPreprocessor.load(mFragmentShaderFile);
+        std::vector<std::string> defines;
+        for(ui32 bit = 0; bit < mDefines.size(); ++bit)
+        {
+            if((mask & (ui64{1} << bit)) == 0)
+                continue;
+
+            const std::string name = getDefineName(mDefines[bit]);
+            if(isNameUsed(vertexShaderSource, name) || isNameUsed(fragmentShaderSource, name))
+                defines.push_back(mDefines[bit]);
+        }
+
+        const std::string& vertexShaderCode = mPreprocessor.expand(mVertexShaderFile, defines);
+        const std::string& fragmentShaderCode = mPreprocessor.expand(mFragmentShaderFile, defines);
+
+        //The stage markers keep "a" + "bc" and "ab" + "c" apart.
+        ui64 sourcesHash = ProgramBinaryCache::hash("vertex:");
+        sourcesHash = ProgramBinaryCache::hash(vertexShaderCode, sourcesHash);
+        sourcesHash = ProgramBinaryCache::hash("fragment:", sourcesHash);
+        sourcesHash = ProgramBinaryCache::hash(fragmentShaderCode, sourcesHash);
+
+        const auto [begin, end] = mProgramsBySource.equal_range(sourcesHash);
+        for(auto iterator = begin; iterator != end; ++iterator)
+        {
+            ProgramEntry* program = iterator->second;
+            if(program->vertexShaderCode == vertexShaderCode && program->fragmentShaderCode == fragmentShaderCode)
+            {
+                mVariants.emplace(mask, program);
+                return *program;
+            }
+        }
+
+        auto program = std::make_unique<ProgramEntry>();
+        program->vertexShaderCode = vertexShaderCode;
+        program->fragmentShaderCode = fragmentShaderCode;
+        mProgramsBySource.emplace(sourcesHash, program.get());
+        mVariants.emplace(mask, program.get());
+        mPrograms.push_back(std::move(program));
+
+        *isAdded = true;
+        return *mPrograms.back();
+    }
+
+    Shader& ShaderVariant::get(ui64 mask)
+    {
+        bool isAdded;
+        auto& program = findOrAddProgram(mask, &isAdded);
+
+        //A program whose build failed is kept, asking for it again throws again.
+        if(!program.shader.isCompiled())
+            program.shader.compileAndLink(program.vertexShaderCode, program.fragmentShaderCode, mProgramBinaryCache);
+
+        return program.shader;
+    }
+
+    void ShaderVariant::precompile(const std::vector<ui64>& masks)
+    {
+        std::vector<ProgramEntry*> addedPrograms;
+        for(const ui64 mask : masks)
+        {
+            bool isAdded;
+            auto& program = findOrAddProgram(mask, &isAdded);
+            if(isAdded)
+                addedPrograms.push_back(&program);
+        }
+
+        for(auto* program : addedPrograms)
+            program->shader.beginCompileAndLink(program->vertexShaderCode, program->fragmentShaderCode, mProgramBinaryCache);
+
+        //Every build is finished before the first failure is rethrown.
+        std::exception_ptr exception;
+        for(auto* program : addedPrograms)
+        {
+            try
+            {
+                program->shader.finishCompileAndLink();
+            }
+            catch(const RSException&)
+            {
+                if(!exception)
+                    exception = std::current_exception();
+            }
+        }
+
+        if(exception)
+            std::rethrow_exception(exception);
+    }
+
+    void ShaderVariant::precompileManifest(const std::string& manifestFile)
+    {
+        std::ifstream inStream(manifestFile, std::ios::in);
+        if(!inStream.is_open())
+            THROW_RS_EXCEPTION("(ShaderVariant::precompileManifest) : Manifest file could not be loaded. " + manifestFile,
+                               RSErrorCode::BGL_ShaderFileLoadingFailed);
+
+        std::vector<ui64> masks;
+        std::string line;
+        while(getline(inStream, line))
+        {
+            std::istringstream lineStream(line);
+            std::vector<std::string> names;
+            std::string name;
+            while(lineStream >> name)
+                names.push_back(name);
+
+            if(names.empty() || names[0][0] == '#')
+                continue;
+
+            if(names.size() == 1 && names[0] == "-")
+                names.clear();
+
+            masks.push_back(getMask(names));
+        }
+
+        precompile(masks);
+    }
+
+    ui64 ShaderVariant::getMask(const std::vector<std::string>& names) const
+    {
+        ui64 mask{0};
+        for(const auto& name : names)
+        {
+            ui32 bit = 0;
+            while(bit < mDefines.size() && getDefineName(mDefines[bit]) != name)
+                ++bit;
+
+            if(bit == mDefines.size())
+                THROW_RS_EXCEPTION("(ShaderVariant::getMask) : Unknown define. " + name, RSErrorCode::BGL_ShaderVariantUnknownDefine);
+
+            mask |= ui64{1} << bit;
+        }
+
+        return mask;
+    }
+}
\ No newline at end of file
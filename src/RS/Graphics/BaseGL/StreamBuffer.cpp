@@ -0,0 +1,204 @@
+/*
+BSD 2-Clause License
+Copyright (c) 2017, Davood Rasti and Alireza Rasti - rastisoft
+All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "RS/Graphics/BaseGL/StreamBuffer.h"
+#include "RS/Exception/RSException.h"
+#include "RS/Graphics/BaseGL/DeletionQueue.h"
+
+#include <cassert>
+#include <utility>
+
+using namespace RS::Exception;
+
+namespace RS::Graphics::BaseGL
+{
+    StreamBuffer::StreamBuffer(GLenum target, ui32 regionSize, ui32 regionCount) :
+        mTarget(target),
+        mRegionSize(regionSize),
+        mRegionCount(regionCount),
+        mRegionFences(regionCount, nullptr)
+    {
+        assert(regionSize > 0 && regionCount > 0);
+
+        glGenBuffers(1, &mBufferId);
+        bindForUpload();
+
+        mIsPersistent = (GLEW_VERSION_4_4 || GLEW_ARB_buffer_storage);
+        if(mIsPersistent)
+        {
+            constexpr GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+            const GLsizeiptr size = static_cast<GLsizeiptr>(mRegionSize) * mRegionCount;
+
+            glBufferStorage(GL_COPY_WRITE_BUFFER, size, nullptr, flags);
+            mMappedPointer = static_cast<ui8*>(glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, size, flags));
+            if(!mMappedPointer)
+                THROW_RS_EXCEPTION("(StreamBuffer) : persistent mapping failed.", RSErrorCode::BGL_MappingBufferFailed);
+        }
+        else
+            glBufferData(GL_COPY_WRITE_BUFFER, mRegionSize, nullptr, GL_STREAM_DRAW);
+    }
+
+    StreamBuffer::StreamBuffer(StreamBuffer&& other) noexcept :
+        mBufferId(std::exchange(other.mBufferId, 0)),
+        mTarget(other.mTarget),
+        mRegionSize(other.mRegionSize),
+        mRegionCount(other.mRegionCount),
+        mRegionIndex(other.mRegionIndex),
+        mRegionOffset(other.mRegionOffset),
+        mRegionFences(std::move(other.mRegionFences)),
+        mMappedPointer(std::exchange(other.mMappedPointer, nullptr)),
+        mMappedOffset(other.mMappedOffset),
+        mIsPersistent(other.mIsPersistent),
+        mFenceWaitCount(other.mFenceWaitCount)
+    {
+        other.mRegionFences.clear();
+    }
+
+    StreamBuffer& StreamBuffer::operator=(StreamBuffer&& other) noexcept
+    {
+        if(this != &other)
+        {
+            release();
+            mBufferId = std::exchange(other.mBufferId, 0);
+            mTarget = other.mTarget;
+            mRegionSize = other.mRegionSize;
+            mRegionCount = other.mRegionCount;
+            mRegionIndex = other.mRegionIndex;
+            mRegionOffset = other.mRegionOffset;
+            mRegionFences = std::move(other.mRegionFences);
+            other.mRegionFences.clear();
+            mMappedPointer = std::exchange(other.mMappedPointer, nullptr);
+            mMappedOffset = other.mMappedOffset;
+            mIsPersistent = other.mIsPersistent;
+            mFenceWaitCount = other.mFenceWaitCount;
+        }
+
+        return *this;
+    }
+
+    StreamBuffer::~StreamBuffer(void)
+    {
+        release();
+    }
+
+    void StreamBuffer::release(void)
+    {
+        for(auto& fence : mRegionFences)
+        {
+            if(fence)
+                glDeleteSync(fence);
+        }
+        mRegionFences.clear();
+
+        if(mMappedPointer)
+        {
+            bindForUpload();
+            glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+            mMappedPointer = nullptr;
+        }
+
+        DeletionQueue::getCurrent().release(GLObjectType::Buffer, mBufferId);
+        mBufferId = 0;
+    }
+
+    StreamAllocation StreamBuffer::allocate(ui32 size, ui32 alignment)
+    {
+        assert(alignment > 0 && (alignment & (alignment - 1)) == 0);
+
+        const ui32 offset = (mRegionOffset + alignment - 1) & ~(alignment - 1);
+        if(offset + size > mRegionSize)
+            THROW_RS_EXCEPTION("(StreamBuffer::allocate) : the frame region is full.", RSErrorCode::BGL_StreamBufferOverflow);
+
+        mRegionOffset = offset + size;
+
+        if(mIsPersistent)
+        {
+            const GLintptr bufferOffset = static_cast<GLintptr>(mRegionIndex) * mRegionSize + offset;
+            return StreamAllocation{mMappedPointer + bufferOffset, bufferOffset};
+        }
+
+        if(!mMappedPointer)
+        {
+            bindForUpload();
+
+            //The first mapping of the frame orphans the store, the GPU keeps
+            //reading the old one while the CPU writes into a new one.
+            GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_FLUSH_EXPLICIT_BIT;
+            flags |= (offset == 0) ? GL_MAP_INVALIDATE_BUFFER_BIT : GL_MAP_INVALIDATE_RANGE_BIT;
+
+            mMappedOffset = offset;
+            mMappedPointer = static_cast<ui8*>(glMapBufferRange(GL_COPY_WRITE_BUFFER, offset, mRegionSize - offset, flags));
+            if(!mMappedPointer)
+                THROW_RS_EXCEPTION("(StreamBuffer::allocate) : mapping failed.", RSErrorCode::BGL_MappingBufferFailed);
+        }
+
+        return StreamAllocation{mMappedPointer + (offset - mMappedOffset), offset};
+    }
+
+    void StreamBuffer::flush(void)
+    {
+        if(mIsPersistent || !mMappedPointer)
+            return;
+
+        bindForUpload();
+        glFlushMappedBufferRange(GL_COPY_WRITE_BUFFER, 0, mRegionOffset - mMappedOffset);
+        glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+        mMappedPointer = nullptr;
+    }
+
+    void StreamBuffer::endFrame(void)
+    {
+        mRegionOffset = 0;
+
+        if(!mIsPersistent)
+        {
+            flush();
+            return;
+        }
+
+        mRegionFences[mRegionIndex] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        mRegionIndex = (mRegionIndex + 1) % mRegionCount;
+        waitForRegion(mRegionIndex);
+    }
+
+    void StreamBuffer::waitForRegion(ui32 regionIndex)
+    {
+        GLsync& fence = mRegionFences[regionIndex];
+        if(!fence)
+            return;
+
+        GLenum result = glClientWaitSync(fence, 0, 0);
+        if(result == GL_TIMEOUT_EXPIRED)
+        {
+            ++mFenceWaitCount;
+
+            constexpr GLuint64 timeout{1000000};
+            do
+                result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, timeout);
+            while(result == GL_TIMEOUT_EXPIRED);
+        }
+
+        glDeleteSync(fence);
+        fence = nullptr;
+    }
+}
\ No newline at end of file
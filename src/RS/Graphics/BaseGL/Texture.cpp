@@ -23,10 +23,12 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "RS/Graphics/BaseGL/Texture.h"
 #include "RS/Exception/RSException.h"
+#include "RS/Graphics/BaseGL/DeletionQueue.h"
 #include "RS/Graphics/BaseGL/3rdparty/stb/stb_image.h"
 
 #include <cassert>
 #include <fstream>
+#include <utility>
 #include <vector>
 
 #include <iostream>
@@ -44,7 +46,7 @@ namespace RS::Graphics::BaseGL
         if(mTextureHandle < 0)
             THROW_RS_EXCEPTION("(Texture) : generating texture failed.", RSErrorCode::BGL_GeneratingTextureFailed);
 
-        glBindTexture(GL_TEXTURE_2D, mTextureHandle);
+        GLStateCache::getCurrent().bindTexture(GL_TEXTURE_2D, mTextureHandle);
 
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
@@ -55,13 +57,38 @@ namespace RS::Graphics::BaseGL
               loadToMemory(textureFile);
     }
 
-    Texture::~Texture(void)
+    Texture::Texture(Texture&& other) noexcept :
+        mImageData(std::exchange(other.mImageData, nullptr)),
+        mFormat(other.mFormat),
+        mTextureHandle(std::exchange(other.mTextureHandle, 0)),
+        mWidth(other.mWidth),
+        mHeight(other.mHeight),
+        mIsLoadedToGPU(std::exchange(other.mIsLoadedToGPU, false)),
+        mIsLoadedToMemory(std::exchange(other.mIsLoadedToMemory, false))
     {
-        if(!mIsLoadedToGPU)
-            return;
+    }
 
-        const GLuint textureHandles[] = {mTextureHandle};
-        glDeleteTextures(1, textureHandles);
+    Texture& Texture::operator=(Texture&& other) noexcept
+    {
+        if(this != &other)
+        {
+            DeletionQueue::getCurrent().release(GLObjectType::Texture, mTextureHandle);
+            mImageData = std::exchange(other.mImageData, nullptr);
+            mFormat = other.mFormat;
+            mTextureHandle = std::exchange(other.mTextureHandle, 0);
+            mWidth = other.mWidth;
+            mHeight = other.mHeight;
+            mIsLoadedToGPU = std::exchange(other.mIsLoadedToGPU, false);
+            mIsLoadedToMemory = std::exchange(other.mIsLoadedToMemory, false);
+        }
+
+        return *this;
+    }
+
+    Texture::~Texture(void)
+    {
+        //The texture name is generated in the constructor, so it is released even if nothing was loaded.
+        DeletionQueue::getCurrent().release(GLObjectType::Texture, mTextureHandle);
         mTextureHandle = 0;
 
         mIsLoadedToGPU = false;
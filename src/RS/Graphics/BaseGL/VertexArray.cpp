@@ -0,0 +1,78 @@
+/*
+BSD 2-Clause License
+Copyright (c) 2017, Davood Rasti and Alireza Rasti - rastisoft
+All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "RS/Graphics/BaseGL/VertexArray.h"
+
+#include <cassert>
+#include <utility>
+
+namespace RS::Graphics::BaseGL
+{
+    VertexArray::VertexArray(void)
+    {
+        glGenVertexArrays(1, &mVertexArrayId);
+    }
+
+    VertexArray::VertexArray(VertexArray&& other) noexcept :
+        mVertexArrayId(std::exchange(other.mVertexArrayId, 0)),
+        mIndexType(std::exchange(other.mIndexType, 0))
+    {
+    }
+
+    VertexArray& VertexArray::operator=(VertexArray&& other) noexcept
+    {
+        if(this != &other)
+        {
+            DeletionQueue::getCurrent().release(GLObjectType::VertexArray, mVertexArrayId);
+            mVertexArrayId = std::exchange(other.mVertexArrayId, 0);
+            mIndexType = std::exchange(other.mIndexType, 0);
+        }
+
+        return *this;
+    }
+
+    VertexArray::~VertexArray(void)
+    {
+        DeletionQueue::getCurrent().release(GLObjectType::VertexArray, mVertexArrayId);
+        mVertexArrayId = 0;
+    }
+
+    void VertexArray::drawElementsInstanced(GLenum mode, i32 indexCount, i32 instanceCount, ui32 firstIndex, i32 baseVertex)
+    {
+        assert(mIndexType != 0);
+
+        ui32 indexSize{4};
+        if(mIndexType == GL_UNSIGNED_BYTE)
+            indexSize = 1;
+        else if(mIndexType == GL_UNSIGNED_SHORT)
+            indexSize = 2;
+
+        const auto indices = reinterpret_cast<const void*>(static_cast<GLintptr>(firstIndex) * indexSize);
+
+        bind();
+        if(baseVertex == 0)
+            glDrawElementsInstanced(mode, indexCount, mIndexType, indices, instanceCount);
+        else
+            glDrawElementsInstancedBaseVertex(mode, indexCount, mIndexType, indices, instanceCount, baseVertex);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,54 @@
+/*
+BSD 2-Clause License
+Copyright (c) 2017, Davood Rasti and Alireza Rasti - rastisoft
+All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "RS/Graphics/BaseGL/VertexArrayCache.h"
+
+#include <functional>
+
+namespace RS::Graphics::BaseGL
+{
+    std::size_t VertexArrayCache::KeyHash::operator()(const Key& key) const noexcept
+    {
+        std::size_t hash = std::hash<const void*>()(key.layout);
+        hash = hash * 31 + key.vertexBuffer;
+        hash = hash * 31 + static_cast<std::size_t>(key.baseOffset);
+        hash = hash * 31 + key.indexBuffer;
+        return hash;
+    }
+
+    void VertexArrayCache::remove(GLuint buffer)
+    {
+        for(auto iterator = mVertexArrays.begin(); iterator != mVertexArrays.end();)
+        {
+            if(iterator->first.vertexBuffer == buffer || iterator->first.indexBuffer == buffer)
+                iterator = mVertexArrays.erase(iterator);
+            else
+                ++iterator;
+        }
+    }
+
+    void VertexArrayCache::clear(void)
+    {
+        mVertexArrays.clear();
+    }
+}
\ No newline at end of file